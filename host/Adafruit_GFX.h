@@ -0,0 +1,91 @@
+// Pixel Buzz Box - Host Adafruit_GFX Stand-in (Primitives, Canvas, 5x7 Text)
+// The subset of Adafruit_GFX the game draws with. Lines, circles, rounded
+// rects, triangles and bitmaps follow the library's own rasterization, so
+// frames match the device pixel for pixel; ellipses use a plain midpoint
+// rasterizer and text a public-domain 5x7 font in the classic glyph cell.
+#pragma once
+
+#include <Arduino.h>
+
+class Adafruit_GFX : public Print {
+public:
+  Adafruit_GFX(int16_t w, int16_t h);
+  virtual ~Adafruit_GFX() {}
+
+  // Devices implement drawPixel; the rest funnel into it unless overridden
+  virtual void drawPixel(int16_t x, int16_t y, uint16_t color) = 0;
+  virtual void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+  virtual void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+  virtual void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+  virtual void fillScreen(uint16_t color);
+  virtual void setRotation(uint8_t r);
+
+  void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color);
+  void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+  void drawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color);
+  void fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color);
+  void drawEllipse(int16_t x0, int16_t y0, int16_t rw, int16_t rh, uint16_t color);
+  void fillEllipse(int16_t x0, int16_t y0, int16_t rw, int16_t rh, uint16_t color);
+  void drawRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, uint16_t color);
+  void fillRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, uint16_t color);
+  void fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2,
+                    uint16_t color);
+  void drawRGBBitmap(int16_t x, int16_t y, const uint16_t *bitmap, int16_t w, int16_t h);
+  void drawRGBBitmap(int16_t x, int16_t y, const uint16_t *bitmap, const uint8_t *mask,
+                     int16_t w, int16_t h);
+
+  // Text: transparent background, 6x8 cell per character at size 1
+  void drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint8_t size);
+  size_t write(uint8_t c) override;
+  using Print::write;
+  void setCursor(int16_t x, int16_t y) { cursorX = x; cursorY = y; }
+  void setTextColor(uint16_t c) { textColor = c; }
+  void setTextSize(uint8_t s) { textSize = s > 0 ? s : 1; }
+  void setTextWrap(bool w) { wrap = w; }
+  int16_t getCursorX() const { return cursorX; }
+  int16_t getCursorY() const { return cursorY; }
+
+  int16_t width() const { return _width; }
+  int16_t height() const { return _height; }
+  uint8_t getRotation() const { return rotation; }
+
+protected:
+  void drawCircleHelper(int16_t x0, int16_t y0, int16_t r, uint8_t corners, uint16_t color);
+  void fillCircleHelper(int16_t x0, int16_t y0, int16_t r, uint8_t corners, int16_t delta,
+                        uint16_t color);
+  void writeLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color);
+
+  int16_t WIDTH, HEIGHT;         // Unrotated size
+  int16_t _width, _height;       // Size at the current rotation
+  int16_t cursorX = 0, cursorY = 0;
+  uint16_t textColor = 0xFFFF;
+  uint8_t textSize = 1;
+  uint8_t rotation = 0;
+  bool wrap = true;
+};
+
+// Offscreen RGB565 canvas, row-major at the unrotated size
+class GFXcanvas16 : public Adafruit_GFX {
+public:
+  GFXcanvas16(uint16_t w, uint16_t h);
+  ~GFXcanvas16();
+  GFXcanvas16(const GFXcanvas16 &) = delete;
+  GFXcanvas16 &operator=(const GFXcanvas16 &) = delete;
+
+  void drawPixel(int16_t x, int16_t y, uint16_t color) override;
+  void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override;
+  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override;
+  void fillScreen(uint16_t color) override;
+  uint16_t getPixel(int16_t x, int16_t y) const;
+  uint16_t *getBuffer() const { return buffer; }
+
+private:
+  uint16_t *buffer;
+};
+
+// Host only: RGB565 widened to 8 bits per channel (bit replication), as
+// written to PPM files
+void hostRgb565To888(uint16_t c, uint8_t rgb[3]);
+
+// Host only: write RGB565 pixels as a binary PPM (P6). Returns false on I/O error.
+bool hostWritePPM(const char *path, const uint16_t *pixels, int w, int h);
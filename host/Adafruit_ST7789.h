@@ -0,0 +1,43 @@
+// Pixel Buzz Box - Host ST7789 Stand-in (Framebuffer Panel)
+// Keeps what the game pushes to the panel in a framebuffer at the current
+// rotation: tiles sent with drawRGBBitmap (the SPI bulk path on hardware)
+// land where they would on glass, and the frame can be dumped as a PPM.
+// Optionally the bulk writes take bus time (16 bits a pixel at a set SPI
+// clock) so frames reach the glass as late as they would on hardware.
+#pragma once
+
+#include <Adafruit_GFX.h>
+#include <SPI.h>
+
+class Adafruit_ST7789 : public Adafruit_GFX {
+public:
+  Adafruit_ST7789(SPIClass *spi, int8_t cs, int8_t dc, int8_t rst);
+  ~Adafruit_ST7789();
+  Adafruit_ST7789(const Adafruit_ST7789 &) = delete;
+  Adafruit_ST7789 &operator=(const Adafruit_ST7789 &) = delete;
+
+  void init(uint16_t width, uint16_t height);
+  void setRotation(uint8_t r) override;
+  void drawPixel(int16_t x, int16_t y, uint16_t color) override;
+
+  // Bulk window write, clipped to the panel
+  using Adafruit_GFX::drawRGBBitmap;
+  void drawRGBBitmap(int16_t x, int16_t y, uint16_t *pcolors, int16_t w, int16_t h);
+
+  // Host only
+  const uint16_t *framebuffer() const { return frame; }
+  uint32_t tilesPushed() const { return tiles; }
+  uint32_t pixelsPushed() const { return pixels; }
+  bool savePPM(const char *path) const;
+  void setBusHz(uint32_t hz) { busHz = hz; busBits = busUs = 0; }   // 0 = transfers take no time
+
+private:
+  void allocFrame();
+
+  uint16_t *frame = nullptr;
+  uint32_t tiles = 0;
+  uint32_t pixels = 0;
+  uint32_t busHz = 0;
+  uint64_t busBits = 0;      // Sent since setBusHz()
+  uint64_t busUs = 0;        // ... and the bus time already charged for them
+};
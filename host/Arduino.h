@@ -0,0 +1,86 @@
+// Pixel Buzz Box - Host Arduino Stand-in (Native Builds)
+// Just enough of the Arduino core for the game and its libraries to build
+// and run on a desktop. Time comes from a virtual clock that host tools
+// advance explicitly, so runs are repeatable and independent of host speed;
+// hostUseRealClock() switches to the host's steady clock for profiling.
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+
+#define CHANGE 1
+#define FALLING 2
+#define RISING 3
+
+// -------------------- TIME --------------------
+uint32_t millis();
+uint32_t micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+static inline void yield() {}
+
+// Host only: move the virtual clock
+void hostSetMicros(uint32_t us);
+void hostAdvanceMicros(uint32_t us);
+
+// Host only: follow the host's steady clock (delays really sleep) instead
+// of the virtual one, so task run times in the scheduler stats are real.
+// Continues from the current time in either direction.
+void hostUseRealClock(bool on);
+
+// -------------------- PINS --------------------
+void pinMode(int pin, int mode);
+void digitalWrite(int pin, int value);
+int digitalRead(int pin);
+int analogRead(int pin);
+
+// Host only: drive an input from outside. A level change runs the pin's
+// attached interrupt on the calling thread, as the edge would on hardware.
+void hostSetPin(int pin, int level);
+void hostSetAnalog(int pin, int value);   // 10-bit; every pin reads 512 until set
+
+// -------------------- INTERRUPTS --------------------
+static inline int digitalPinToInterrupt(int pin) { return pin; }
+void attachInterrupt(int irq, void (*fn)(), int mode);
+void detachInterrupt(int irq);
+
+// No preemption on the host: interrupts run from hostSetPin, and the
+// audio thread only shares state through lock-free queues
+static inline void noInterrupts() {}
+static inline void interrupts() {}
+
+// -------------------- TONE --------------------
+// Nothing sounds; the latest request per pin is kept for inspection.
+void tone(int pin, unsigned int freq, unsigned long durationMs = 0);
+void noTone(int pin);
+unsigned int hostToneFreq(int pin);
+
+// -------------------- PRINT --------------------
+// Text sink base, as in the Arduino core; Adafruit_GFX draws through it.
+class Print {
+public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c) = 0;
+  size_t write(const char *s);
+
+  size_t print(const char *s);
+  size_t print(char c);
+  size_t print(int v);
+  size_t print(unsigned int v);
+  size_t print(long v);
+  size_t print(unsigned long v);
+  size_t print(double v, int digits = 2);
+  size_t println();
+  size_t println(const char *s);
+  size_t println(int v);
+};
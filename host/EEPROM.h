@@ -0,0 +1,30 @@
+// Pixel Buzz Box - Host EEPROM Stand-in
+// RAM-backed and erased (0xFF) at start, so every run boots uncalibrated.
+#pragma once
+
+#include <Arduino.h>
+
+class EEPROMClass {
+public:
+  EEPROMClass() { memset(bytes, 0xFF, sizeof(bytes)); }
+
+  void begin(size_t size) { used = size < sizeof(bytes) ? size : sizeof(bytes); }
+
+  template <typename T> T &get(int addr, T &t) {
+    if (addr >= 0 && (size_t)addr + sizeof(T) <= used) memcpy(&t, bytes + addr, sizeof(T));
+    return t;
+  }
+
+  template <typename T> const T &put(int addr, const T &t) {
+    if (addr >= 0 && (size_t)addr + sizeof(T) <= used) memcpy(bytes + addr, &t, sizeof(T));
+    return t;
+  }
+
+  bool commit() { return used > 0; }
+
+private:
+  uint8_t bytes[4096];
+  size_t used = 0;
+};
+
+extern EEPROMClass EEPROM;
@@ -0,0 +1,15 @@
+// Pixel Buzz Box - Host SPI Stand-in
+// Pin routing and bus setup only; panel traffic goes to the ST7789 stand-in.
+#pragma once
+
+#include <Arduino.h>
+
+class SPIClass {
+public:
+  void setSCK(int pin) { (void)pin; }
+  void setTX(int pin) { (void)pin; }
+  void setRX(int pin) { (void)pin; }
+  void begin() {}
+};
+
+extern SPIClass SPI;
@@ -0,0 +1,155 @@
+// Pixel Buzz Box - Host Arduino Stand-in (Virtual Clock, Pins)
+#include <Arduino.h>
+#include <EEPROM.h>
+#include <chrono>
+#include <thread>
+
+static const int HOST_PINS = 30;
+
+// Read from the audio thread as well, hence the atomic accesses
+static uint32_t clockUs = 0;
+static bool realClock = false;
+static std::chrono::steady_clock::time_point realBase;
+
+static uint8_t pinLevel[HOST_PINS];
+static int16_t analogLevel[HOST_PINS];
+static bool analogSet[HOST_PINS];
+static void (*pinIsr[HOST_PINS])();
+static int pinIsrMode[HOST_PINS];
+static unsigned int toneFreq[HOST_PINS];
+
+EEPROMClass EEPROM;
+
+// -------------------- TIME --------------------
+static uint32_t realMicros() {
+  return (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - realBase).count();
+}
+
+uint32_t micros() {
+  if (__atomic_load_n(&realClock, __ATOMIC_ACQUIRE)) return realMicros();
+  return __atomic_load_n(&clockUs, __ATOMIC_RELAXED);
+}
+
+uint32_t millis() { return micros() / 1000u; }
+void hostSetMicros(uint32_t us) { __atomic_store_n(&clockUs, us, __ATOMIC_RELAXED); }
+void hostAdvanceMicros(uint32_t us) { __atomic_fetch_add(&clockUs, us, __ATOMIC_RELAXED); }
+
+void delayMicroseconds(uint32_t us) {
+  if (__atomic_load_n(&realClock, __ATOMIC_ACQUIRE)) {
+    std::this_thread::sleep_for(std::chrono::microseconds(us));
+  } else {
+    hostAdvanceMicros(us);
+  }
+}
+
+void delay(uint32_t ms) { delayMicroseconds(ms * 1000u); }
+
+// Set up on the main thread before anything else reads the clock
+void hostUseRealClock(bool on) {
+  if (on == realClock) return;
+  if (on) {
+    realBase = std::chrono::steady_clock::now() - std::chrono::microseconds(clockUs);
+  } else {
+    clockUs = realMicros();
+  }
+  __atomic_store_n(&realClock, on, __ATOMIC_RELEASE);
+}
+
+// -------------------- PINS --------------------
+static bool validPin(int pin) { return pin >= 0 && pin < HOST_PINS; }
+
+void pinMode(int pin, int mode) {
+  if (validPin(pin) && mode == INPUT_PULLUP) pinLevel[pin] = HIGH;
+}
+
+void digitalWrite(int pin, int value) {
+  if (validPin(pin)) pinLevel[pin] = (uint8_t)(value ? HIGH : LOW);
+}
+
+int digitalRead(int pin) {
+  return validPin(pin) ? pinLevel[pin] : LOW;
+}
+
+// Mid-scale, i.e. a centred stick, until a tool sets the pin
+int analogRead(int pin) {
+  if (!validPin(pin) || !analogSet[pin]) return 512;
+  return analogLevel[pin];
+}
+
+void hostSetAnalog(int pin, int value) {
+  if (!validPin(pin)) return;
+  analogLevel[pin] = (int16_t)(value < 0 ? 0 : (value > 1023 ? 1023 : value));
+  analogSet[pin] = true;
+}
+
+void hostSetPin(int pin, int level) {
+  if (!validPin(pin)) return;
+  uint8_t prev = pinLevel[pin];
+  pinLevel[pin] = (uint8_t)(level ? HIGH : LOW);
+  if (prev == pinLevel[pin] || !pinIsr[pin]) return;
+
+  bool rising = pinLevel[pin] == HIGH;
+  int mode = pinIsrMode[pin];
+  if (mode == CHANGE || (mode == RISING && rising) || (mode == FALLING && !rising)) pinIsr[pin]();
+}
+
+// -------------------- INTERRUPTS --------------------
+void attachInterrupt(int irq, void (*fn)(), int mode) {
+  if (!validPin(irq)) return;
+  pinIsr[irq] = fn;
+  pinIsrMode[irq] = mode;
+}
+
+void detachInterrupt(int irq) {
+  if (validPin(irq)) pinIsr[irq] = nullptr;
+}
+
+// -------------------- TONE --------------------
+void tone(int pin, unsigned int freq, unsigned long durationMs) {
+  (void)durationMs;
+  if (validPin(pin)) toneFreq[pin] = freq;
+}
+
+void noTone(int pin) {
+  if (validPin(pin)) toneFreq[pin] = 0;
+}
+
+unsigned int hostToneFreq(int pin) {
+  return validPin(pin) ? toneFreq[pin] : 0;
+}
+
+// -------------------- PRINT --------------------
+size_t Print::write(const char *s) {
+  size_t n = 0;
+  while (*s) n += write((uint8_t)*s++);
+  return n;
+}
+
+size_t Print::print(const char *s) { return write(s); }
+size_t Print::print(char c) { return write((uint8_t)c); }
+
+size_t Print::print(long v) {
+  char buf[24];
+  snprintf(buf, sizeof(buf), "%ld", v);
+  return write(buf);
+}
+
+size_t Print::print(unsigned long v) {
+  char buf[24];
+  snprintf(buf, sizeof(buf), "%lu", v);
+  return write(buf);
+}
+
+size_t Print::print(int v) { return print((long)v); }
+size_t Print::print(unsigned int v) { return print((unsigned long)v); }
+
+size_t Print::print(double v, int digits) {
+  char buf[40];
+  snprintf(buf, sizeof(buf), "%.*f", digits, v);
+  return write(buf);
+}
+
+size_t Print::println() { return write((uint8_t)'\r') + write((uint8_t)'\n'); }
+size_t Print::println(const char *s) { return print(s) + println(); }
+size_t Print::println(int v) { return print(v) + println(); }
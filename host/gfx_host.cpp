@@ -0,0 +1,532 @@
+// Pixel Buzz Box - Host Adafruit_GFX Stand-in (Rasterizers, Canvas, Font, PPM)
+#include <Adafruit_GFX.h>
+
+static inline void swapi(int16_t &a, int16_t &b) { int16_t t = a; a = b; b = t; }
+
+// -------------------- FONT --------------------
+// 5x7 glyphs for ASCII 0x20..0x7E, one byte per column, bit 0 at the top
+static const uint8_t FONT_FIRST = 0x20;
+static const uint8_t FONT_LAST = 0x7E;
+static const uint8_t font5x7[(FONT_LAST - FONT_FIRST + 1) * 5] = {
+  0x00, 0x00, 0x00, 0x00, 0x00,   // ' '
+  0x00, 0x00, 0x5F, 0x00, 0x00,   // '!'
+  0x00, 0x07, 0x00, 0x07, 0x00,   // '"'
+  0x14, 0x7F, 0x14, 0x7F, 0x14,   // '#'
+  0x24, 0x2A, 0x7F, 0x2A, 0x12,   // '$'
+  0x23, 0x13, 0x08, 0x64, 0x62,   // '%'
+  0x36, 0x49, 0x55, 0x22, 0x50,   // '&'
+  0x00, 0x05, 0x03, 0x00, 0x00,   // '''
+  0x00, 0x1C, 0x22, 0x41, 0x00,   // '('
+  0x00, 0x41, 0x22, 0x1C, 0x00,   // ')'
+  0x08, 0x2A, 0x1C, 0x2A, 0x08,   // '*'
+  0x08, 0x08, 0x3E, 0x08, 0x08,   // '+'
+  0x00, 0x50, 0x30, 0x00, 0x00,   // ','
+  0x08, 0x08, 0x08, 0x08, 0x08,   // '-'
+  0x00, 0x60, 0x60, 0x00, 0x00,   // '.'
+  0x20, 0x10, 0x08, 0x04, 0x02,   // '/'
+  0x3E, 0x51, 0x49, 0x45, 0x3E,   // '0'
+  0x00, 0x42, 0x7F, 0x40, 0x00,   // '1'
+  0x42, 0x61, 0x51, 0x49, 0x46,   // '2'
+  0x21, 0x41, 0x45, 0x4B, 0x31,   // '3'
+  0x18, 0x14, 0x12, 0x7F, 0x10,   // '4'
+  0x27, 0x45, 0x45, 0x45, 0x39,   // '5'
+  0x3C, 0x4A, 0x49, 0x49, 0x30,   // '6'
+  0x01, 0x71, 0x09, 0x05, 0x03,   // '7'
+  0x36, 0x49, 0x49, 0x49, 0x36,   // '8'
+  0x06, 0x49, 0x49, 0x29, 0x1E,   // '9'
+  0x00, 0x36, 0x36, 0x00, 0x00,   // ':'
+  0x00, 0x56, 0x36, 0x00, 0x00,   // ';'
+  0x08, 0x14, 0x22, 0x41, 0x00,   // '<'
+  0x14, 0x14, 0x14, 0x14, 0x14,   // '='
+  0x00, 0x41, 0x22, 0x14, 0x08,   // '>'
+  0x02, 0x01, 0x51, 0x09, 0x06,   // '?'
+  0x32, 0x49, 0x79, 0x41, 0x3E,   // '@'
+  0x7E, 0x11, 0x11, 0x11, 0x7E,   // 'A'
+  0x7F, 0x49, 0x49, 0x49, 0x36,   // 'B'
+  0x3E, 0x41, 0x41, 0x41, 0x22,   // 'C'
+  0x7F, 0x41, 0x41, 0x22, 0x1C,   // 'D'
+  0x7F, 0x49, 0x49, 0x49, 0x41,   // 'E'
+  0x7F, 0x09, 0x09, 0x09, 0x01,   // 'F'
+  0x3E, 0x41, 0x49, 0x49, 0x7A,   // 'G'
+  0x7F, 0x08, 0x08, 0x08, 0x7F,   // 'H'
+  0x00, 0x41, 0x7F, 0x41, 0x00,   // 'I'
+  0x20, 0x40, 0x41, 0x3F, 0x01,   // 'J'
+  0x7F, 0x08, 0x14, 0x22, 0x41,   // 'K'
+  0x7F, 0x40, 0x40, 0x40, 0x40,   // 'L'
+  0x7F, 0x02, 0x0C, 0x02, 0x7F,   // 'M'
+  0x7F, 0x04, 0x08, 0x10, 0x7F,   // 'N'
+  0x3E, 0x41, 0x41, 0x41, 0x3E,   // 'O'
+  0x7F, 0x09, 0x09, 0x09, 0x06,   // 'P'
+  0x3E, 0x41, 0x51, 0x21, 0x5E,   // 'Q'
+  0x7F, 0x09, 0x19, 0x29, 0x46,   // 'R'
+  0x46, 0x49, 0x49, 0x49, 0x31,   // 'S'
+  0x01, 0x01, 0x7F, 0x01, 0x01,   // 'T'
+  0x3F, 0x40, 0x40, 0x40, 0x3F,   // 'U'
+  0x1F, 0x20, 0x40, 0x20, 0x1F,   // 'V'
+  0x3F, 0x40, 0x38, 0x40, 0x3F,   // 'W'
+  0x63, 0x14, 0x08, 0x14, 0x63,   // 'X'
+  0x07, 0x08, 0x70, 0x08, 0x07,   // 'Y'
+  0x61, 0x51, 0x49, 0x45, 0x43,   // 'Z'
+  0x00, 0x7F, 0x41, 0x41, 0x00,   // '['
+  0x02, 0x04, 0x08, 0x10, 0x20,   // '\'
+  0x00, 0x41, 0x41, 0x7F, 0x00,   // ']'
+  0x04, 0x02, 0x01, 0x02, 0x04,   // '^'
+  0x40, 0x40, 0x40, 0x40, 0x40,   // '_'
+  0x00, 0x01, 0x02, 0x04, 0x00,   // '`'
+  0x20, 0x54, 0x54, 0x54, 0x78,   // 'a'
+  0x7F, 0x48, 0x44, 0x44, 0x38,   // 'b'
+  0x38, 0x44, 0x44, 0x44, 0x20,   // 'c'
+  0x38, 0x44, 0x44, 0x48, 0x7F,   // 'd'
+  0x38, 0x54, 0x54, 0x54, 0x18,   // 'e'
+  0x08, 0x7E, 0x09, 0x01, 0x02,   // 'f'
+  0x0C, 0x52, 0x52, 0x52, 0x3E,   // 'g'
+  0x7F, 0x08, 0x04, 0x04, 0x78,   // 'h'
+  0x00, 0x44, 0x7D, 0x40, 0x00,   // 'i'
+  0x20, 0x40, 0x44, 0x3D, 0x00,   // 'j'
+  0x7F, 0x10, 0x28, 0x44, 0x00,   // 'k'
+  0x00, 0x41, 0x7F, 0x40, 0x00,   // 'l'
+  0x7C, 0x04, 0x18, 0x04, 0x78,   // 'm'
+  0x7C, 0x08, 0x04, 0x04, 0x78,   // 'n'
+  0x38, 0x44, 0x44, 0x44, 0x38,   // 'o'
+  0x7C, 0x14, 0x14, 0x14, 0x08,   // 'p'
+  0x08, 0x14, 0x14, 0x18, 0x7C,   // 'q'
+  0x7C, 0x08, 0x04, 0x04, 0x08,   // 'r'
+  0x48, 0x54, 0x54, 0x54, 0x20,   // 's'
+  0x04, 0x3F, 0x44, 0x40, 0x20,   // 't'
+  0x3C, 0x40, 0x40, 0x20, 0x7C,   // 'u'
+  0x1C, 0x20, 0x40, 0x20, 0x1C,   // 'v'
+  0x3C, 0x40, 0x30, 0x40, 0x3C,   // 'w'
+  0x44, 0x28, 0x10, 0x28, 0x44,   // 'x'
+  0x0C, 0x50, 0x50, 0x50, 0x3C,   // 'y'
+  0x44, 0x64, 0x54, 0x4C, 0x44,   // 'z'
+  0x00, 0x08, 0x36, 0x41, 0x00,   // '{'
+  0x00, 0x00, 0x7F, 0x00, 0x00,   // '|'
+  0x00, 0x41, 0x36, 0x08, 0x00,   // '}'
+  0x08, 0x04, 0x08, 0x10, 0x08,   // '~'
+};
+
+// -------------------- ADAFRUIT_GFX --------------------
+Adafruit_GFX::Adafruit_GFX(int16_t w, int16_t h) : WIDTH(w), HEIGHT(h), _width(w), _height(h) {}
+
+void Adafruit_GFX::setRotation(uint8_t r) {
+  rotation = r & 3;
+  _width = (rotation & 1) ? HEIGHT : WIDTH;
+  _height = (rotation & 1) ? WIDTH : HEIGHT;
+}
+
+void Adafruit_GFX::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+  for (int16_t i = 0; i < h; i++) drawPixel(x, (int16_t)(y + i), color);
+}
+
+void Adafruit_GFX::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+  for (int16_t i = 0; i < w; i++) drawPixel((int16_t)(x + i), y, color);
+}
+
+void Adafruit_GFX::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+  for (int16_t i = x; i < x + w; i++) drawFastVLine(i, y, h, color);
+}
+
+void Adafruit_GFX::fillScreen(uint16_t color) {
+  fillRect(0, 0, _width, _height, color);
+}
+
+// Bresenham, stepping along the major axis
+void Adafruit_GFX::writeLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+  bool steep = abs(y1 - y0) > abs(x1 - x0);
+  if (steep) { swapi(x0, y0); swapi(x1, y1); }
+  if (x0 > x1) { swapi(x0, x1); swapi(y0, y1); }
+
+  int16_t dx = x1 - x0;
+  int16_t dy = (int16_t)abs(y1 - y0);
+  int16_t err = dx / 2;
+  int16_t ystep = (y0 < y1) ? 1 : -1;
+  for (; x0 <= x1; x0++) {
+    if (steep) drawPixel(y0, x0, color);
+    else drawPixel(x0, y0, color);
+    err -= dy;
+    if (err < 0) {
+      y0 += ystep;
+      err += dx;
+    }
+  }
+}
+
+void Adafruit_GFX::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+  if (x0 == x1) {
+    if (y0 > y1) swapi(y0, y1);
+    drawFastVLine(x0, y0, (int16_t)(y1 - y0 + 1), color);
+  } else if (y0 == y1) {
+    if (x0 > x1) swapi(x0, x1);
+    drawFastHLine(x0, y0, (int16_t)(x1 - x0 + 1), color);
+  } else {
+    writeLine(x0, y0, x1, y1, color);
+  }
+}
+
+void Adafruit_GFX::drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+  drawFastHLine(x, y, w, color);
+  drawFastHLine(x, (int16_t)(y + h - 1), w, color);
+  drawFastVLine(x, y, h, color);
+  drawFastVLine((int16_t)(x + w - 1), y, h, color);
+}
+
+// -------------------- CIRCLES --------------------
+void Adafruit_GFX::drawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {
+  int16_t f = 1 - r;
+  int16_t ddFx = 1;
+  int16_t ddFy = -2 * r;
+  int16_t x = 0;
+  int16_t y = r;
+
+  drawPixel(x0, y0 + r, color);
+  drawPixel(x0, y0 - r, color);
+  drawPixel(x0 + r, y0, color);
+  drawPixel(x0 - r, y0, color);
+  while (x < y) {
+    if (f >= 0) {
+      y--;
+      ddFy += 2;
+      f += ddFy;
+    }
+    x++;
+    ddFx += 2;
+    f += ddFx;
+    drawPixel(x0 + x, y0 + y, color);
+    drawPixel(x0 - x, y0 + y, color);
+    drawPixel(x0 + x, y0 - y, color);
+    drawPixel(x0 - x, y0 - y, color);
+    drawPixel(x0 + y, y0 + x, color);
+    drawPixel(x0 - y, y0 + x, color);
+    drawPixel(x0 + y, y0 - x, color);
+    drawPixel(x0 - y, y0 - x, color);
+  }
+}
+
+// Quarter arcs: 1 = top left, 2 = top right, 4 = bottom right, 8 = bottom left
+void Adafruit_GFX::drawCircleHelper(int16_t x0, int16_t y0, int16_t r, uint8_t corners,
+                                    uint16_t color) {
+  int16_t f = 1 - r;
+  int16_t ddFx = 1;
+  int16_t ddFy = -2 * r;
+  int16_t x = 0;
+  int16_t y = r;
+
+  while (x < y) {
+    if (f >= 0) {
+      y--;
+      ddFy += 2;
+      f += ddFy;
+    }
+    x++;
+    ddFx += 2;
+    f += ddFx;
+    if (corners & 0x4) {
+      drawPixel(x0 + x, y0 + y, color);
+      drawPixel(x0 + y, y0 + x, color);
+    }
+    if (corners & 0x2) {
+      drawPixel(x0 + x, y0 - y, color);
+      drawPixel(x0 + y, y0 - x, color);
+    }
+    if (corners & 0x8) {
+      drawPixel(x0 - y, y0 + x, color);
+      drawPixel(x0 - x, y0 + y, color);
+    }
+    if (corners & 0x1) {
+      drawPixel(x0 - y, y0 - x, color);
+      drawPixel(x0 - x, y0 - y, color);
+    }
+  }
+}
+
+// Vertical spans of the right (1) and/or left (2) half, stretched by delta
+void Adafruit_GFX::fillCircleHelper(int16_t x0, int16_t y0, int16_t r, uint8_t corners,
+                                    int16_t delta, uint16_t color) {
+  int16_t f = 1 - r;
+  int16_t ddFx = 1;
+  int16_t ddFy = -2 * r;
+  int16_t x = 0;
+  int16_t y = r;
+  int16_t px = x;
+  int16_t py = y;
+
+  delta++;
+  while (x < y) {
+    if (f >= 0) {
+      y--;
+      ddFy += 2;
+      f += ddFy;
+    }
+    x++;
+    ddFx += 2;
+    f += ddFx;
+    // Skip spans the previous step already drew
+    if (x < (y + 1)) {
+      if (corners & 1) drawFastVLine(x0 + x, y0 - y, 2 * y + delta, color);
+      if (corners & 2) drawFastVLine(x0 - x, y0 - y, 2 * y + delta, color);
+    }
+    if (y != py) {
+      if (corners & 1) drawFastVLine(x0 + py, y0 - px, 2 * px + delta, color);
+      if (corners & 2) drawFastVLine(x0 - py, y0 - px, 2 * px + delta, color);
+      py = y;
+    }
+    px = x;
+  }
+}
+
+void Adafruit_GFX::fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {
+  drawFastVLine(x0, y0 - r, 2 * r + 1, color);
+  fillCircleHelper(x0, y0, r, 3, 0, color);
+}
+
+// -------------------- ELLIPSES --------------------
+// Midpoint ellipse in two regions (slope above and below -1), in 64-bit
+// so large radii cannot overflow. fill draws a span per row instead.
+static void ellipsePoints(Adafruit_GFX &g, int16_t x0, int16_t y0, int16_t rw, int16_t rh,
+                          uint16_t color, bool fill) {
+  if (rw < 0 || rh < 0) return;
+  int64_t a2 = (int64_t)rw * rw;
+  int64_t b2 = (int64_t)rh * rh;
+  int64_t x = 0, y = rh;
+
+  auto plot = [&](int64_t px, int64_t py) {
+    if (fill) {
+      g.drawFastHLine((int16_t)(x0 - px), (int16_t)(y0 - py), (int16_t)(2 * px + 1), color);
+      g.drawFastHLine((int16_t)(x0 - px), (int16_t)(y0 + py), (int16_t)(2 * px + 1), color);
+    } else {
+      g.drawPixel((int16_t)(x0 + px), (int16_t)(y0 + py), color);
+      g.drawPixel((int16_t)(x0 - px), (int16_t)(y0 + py), color);
+      g.drawPixel((int16_t)(x0 + px), (int16_t)(y0 - py), color);
+      g.drawPixel((int16_t)(x0 - px), (int16_t)(y0 - py), color);
+    }
+  };
+
+  // Region 1: step x, decision scaled by 4 to stay integral
+  int64_t d = 4 * b2 - 4 * a2 * rh + a2;
+  while (b2 * x <= a2 * y) {
+    plot(x, y);
+    if (d >= 0) {
+      y--;
+      d -= 8 * a2 * y;
+    }
+    x++;
+    d += 4 * b2 * (2 * x + 1);
+  }
+
+  // Region 2: step y
+  d = b2 * (2 * x + 1) * (2 * x + 1) + 4 * a2 * (y - 1) * (y - 1) - 4 * a2 * b2;
+  while (y >= 0) {
+    plot(x, y);
+    if (d <= 0) {
+      x++;
+      d += 8 * b2 * x;
+    }
+    y--;
+    d += 4 * a2 * (1 - 2 * y);
+  }
+}
+
+void Adafruit_GFX::drawEllipse(int16_t x0, int16_t y0, int16_t rw, int16_t rh, uint16_t color) {
+  ellipsePoints(*this, x0, y0, rw, rh, color, false);
+}
+
+void Adafruit_GFX::fillEllipse(int16_t x0, int16_t y0, int16_t rw, int16_t rh, uint16_t color) {
+  ellipsePoints(*this, x0, y0, rw, rh, color, true);
+}
+
+// -------------------- ROUNDED RECTS --------------------
+void Adafruit_GFX::drawRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r,
+                                 uint16_t color) {
+  int16_t maxRadius = ((w < h) ? w : h) / 2;
+  if (r > maxRadius) r = maxRadius;
+  drawFastHLine(x + r, y, w - 2 * r, color);
+  drawFastHLine(x + r, y + h - 1, w - 2 * r, color);
+  drawFastVLine(x, y + r, h - 2 * r, color);
+  drawFastVLine(x + w - 1, y + r, h - 2 * r, color);
+  drawCircleHelper(x + r, y + r, r, 1, color);
+  drawCircleHelper(x + w - r - 1, y + r, r, 2, color);
+  drawCircleHelper(x + w - r - 1, y + h - r - 1, r, 4, color);
+  drawCircleHelper(x + r, y + h - r - 1, r, 8, color);
+}
+
+void Adafruit_GFX::fillRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r,
+                                 uint16_t color) {
+  int16_t maxRadius = ((w < h) ? w : h) / 2;
+  if (r > maxRadius) r = maxRadius;
+  fillRect(x + r, y, w - 2 * r, h, color);
+  fillCircleHelper(x + w - r - 1, y + r, r, 1, h - 2 * r - 1, color);
+  fillCircleHelper(x + r, y + r, r, 2, h - 2 * r - 1, color);
+}
+
+// -------------------- TRIANGLES --------------------
+// Scanline fill: upper part between edges 0-1 and 0-2, lower part 1-2 and 0-2
+void Adafruit_GFX::fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2,
+                                int16_t y2, uint16_t color) {
+  if (y0 > y1) { swapi(y0, y1); swapi(x0, x1); }
+  if (y1 > y2) { swapi(y2, y1); swapi(x2, x1); }
+  if (y0 > y1) { swapi(y0, y1); swapi(x0, x1); }
+
+  if (y0 == y2) {
+    int16_t a = x0, b = x0;
+    if (x1 < a) a = x1;
+    else if (x1 > b) b = x1;
+    if (x2 < a) a = x2;
+    else if (x2 > b) b = x2;
+    drawFastHLine(a, y0, b - a + 1, color);
+    return;
+  }
+
+  int16_t dx01 = x1 - x0, dy01 = y1 - y0;
+  int16_t dx02 = x2 - x0, dy02 = y2 - y0;
+  int16_t dx12 = x2 - x1, dy12 = y2 - y1;
+  int32_t sa = 0, sb = 0;
+
+  // A flat bottom includes its last row here; otherwise the lower loop does
+  int16_t last = (y1 == y2) ? y1 : (int16_t)(y1 - 1);
+  int16_t y;
+  for (y = y0; y <= last; y++) {
+    int16_t a = (int16_t)(x0 + sa / dy01);
+    int16_t b = (int16_t)(x0 + sb / dy02);
+    sa += dx01;
+    sb += dx02;
+    if (a > b) swapi(a, b);
+    drawFastHLine(a, y, b - a + 1, color);
+  }
+
+  sa = (int32_t)dx12 * (y - y1);
+  sb = (int32_t)dx02 * (y - y0);
+  for (; y <= y2; y++) {
+    int16_t a = (int16_t)(x1 + sa / dy12);
+    int16_t b = (int16_t)(x0 + sb / dy02);
+    sa += dx12;
+    sb += dx02;
+    if (a > b) swapi(a, b);
+    drawFastHLine(a, y, b - a + 1, color);
+  }
+}
+
+// -------------------- BITMAPS --------------------
+void Adafruit_GFX::drawRGBBitmap(int16_t x, int16_t y, const uint16_t *bitmap, int16_t w,
+                                 int16_t h) {
+  for (int16_t j = 0; j < h; j++) {
+    for (int16_t i = 0; i < w; i++) drawPixel(x + i, y + j, bitmap[j * w + i]);
+  }
+}
+
+// 1-bit mask, rows padded to whole bytes, MSB first
+void Adafruit_GFX::drawRGBBitmap(int16_t x, int16_t y, const uint16_t *bitmap,
+                                 const uint8_t *mask, int16_t w, int16_t h) {
+  int16_t stride = (w + 7) / 8;
+  for (int16_t j = 0; j < h; j++) {
+    for (int16_t i = 0; i < w; i++) {
+      if (mask[j * stride + i / 8] & (0x80 >> (i & 7))) drawPixel(x + i, y + j, bitmap[j * w + i]);
+    }
+  }
+}
+
+// -------------------- TEXT --------------------
+// Unknown characters draw as a hollow box so they stand out in dumps
+void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color,
+                            uint8_t size) {
+  if (x >= _width || y >= _height || (x + 6 * size - 1) < 0 || (y + 8 * size - 1) < 0) return;
+
+  static const uint8_t missing[5] = {0x7F, 0x41, 0x41, 0x41, 0x7F};
+  const uint8_t *glyph = (c >= FONT_FIRST && c <= FONT_LAST) ? &font5x7[(c - FONT_FIRST) * 5] : missing;
+  for (int8_t i = 0; i < 5; i++) {
+    uint8_t line = glyph[i];
+    for (int8_t j = 0; j < 8; j++, line >>= 1) {
+      if (!(line & 1)) continue;
+      if (size == 1) drawPixel(x + i, y + j, color);
+      else fillRect(x + i * size, y + j * size, size, size, color);
+    }
+  }
+}
+
+size_t Adafruit_GFX::write(uint8_t c) {
+  if (c == '\n') {
+    cursorX = 0;
+    cursorY += textSize * 8;
+  } else if (c != '\r') {
+    if (wrap && (cursorX + textSize * 6) > _width) {
+      cursorX = 0;
+      cursorY += textSize * 8;
+    }
+    drawChar(cursorX, cursorY, c, textColor, textSize);
+    cursorX += textSize * 6;
+  }
+  return 1;
+}
+
+// -------------------- CANVAS --------------------
+GFXcanvas16::GFXcanvas16(uint16_t w, uint16_t h) : Adafruit_GFX((int16_t)w, (int16_t)h) {
+  buffer = (uint16_t *)calloc((size_t)w * h, sizeof(uint16_t));
+}
+
+GFXcanvas16::~GFXcanvas16() {
+  free(buffer);
+}
+
+void GFXcanvas16::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  if (x < 0 || y < 0 || x >= _width || y >= _height) return;
+  int16_t t;
+  switch (rotation) {
+    case 1: t = x; x = WIDTH - 1 - y; y = t; break;
+    case 2: x = WIDTH - 1 - x; y = HEIGHT - 1 - y; break;
+    case 3: t = x; x = y; y = HEIGHT - 1 - t; break;
+  }
+  buffer[y * WIDTH + x] = color;
+}
+
+uint16_t GFXcanvas16::getPixel(int16_t x, int16_t y) const {
+  if (x < 0 || y < 0 || x >= _width || y >= _height) return 0;
+  int16_t t;
+  switch (rotation) {
+    case 1: t = x; x = WIDTH - 1 - y; y = t; break;
+    case 2: x = WIDTH - 1 - x; y = HEIGHT - 1 - y; break;
+    case 3: t = x; x = y; y = HEIGHT - 1 - t; break;
+  }
+  return buffer[y * WIDTH + x];
+}
+
+// Clipped spans straight into the buffer when unrotated
+void GFXcanvas16::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+  if (rotation != 0) { Adafruit_GFX::drawFastHLine(x, y, w, color); return; }
+  if (y < 0 || y >= HEIGHT) return;
+  int16_t x1 = x + w;
+  if (x < 0) x = 0;
+  if (x1 > WIDTH) x1 = WIDTH;
+  for (uint16_t *p = buffer + y * WIDTH; x < x1; x++) p[x] = color;
+}
+
+void GFXcanvas16::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+  if (rotation != 0) { Adafruit_GFX::drawFastVLine(x, y, h, color); return; }
+  if (x < 0 || x >= WIDTH) return;
+  int16_t y1 = y + h;
+  if (y < 0) y = 0;
+  if (y1 > HEIGHT) y1 = HEIGHT;
+  for (; y < y1; y++) buffer[y * WIDTH + x] = color;
+}
+
+void GFXcanvas16::fillScreen(uint16_t color) {
+  for (int32_t i = 0; i < (int32_t)WIDTH * HEIGHT; i++) buffer[i] = color;
+}
+
+// -------------------- PPM --------------------
+void hostRgb565To888(uint16_t c, uint8_t rgb[3]) {
+  uint8_t r = (uint8_t)((c >> 11) & 0x1F), g = (uint8_t)((c >> 5) & 0x3F), b = (uint8_t)(c & 0x1F);
+  rgb[0] = (uint8_t)((r << 3) | (r >> 2));
+  rgb[1] = (uint8_t)((g << 2) | (g >> 4));
+  rgb[2] = (uint8_t)((b << 3) | (b >> 2));
+}
+
+bool hostWritePPM(const char *path, const uint16_t *pixels, int w, int h) {
+  FILE *f = fopen(path, "wb");
+  if (!f) return false;
+  fprintf(f, "P6\n%d %d\n255\n", w, h);
+  for (int i = 0; i < w * h; i++) {
+    uint8_t rgb[3];
+    hostRgb565To888(pixels[i], rgb);
+    fwrite(rgb, 1, 3, f);
+  }
+  return fclose(f) == 0;
+}
@@ -0,0 +1,66 @@
+// Pixel Buzz Box - Host ST7789 Stand-in (Framebuffer Panel, SPI Bus)
+#include <Adafruit_ST7789.h>
+
+SPIClass SPI;
+
+// Same 240x320 default as the library until init() gives the real size
+Adafruit_ST7789::Adafruit_ST7789(SPIClass *spi, int8_t cs, int8_t dc, int8_t rst)
+    : Adafruit_GFX(240, 320) {
+  (void)spi;
+  (void)cs;
+  (void)dc;
+  (void)rst;
+}
+
+Adafruit_ST7789::~Adafruit_ST7789() {
+  free(frame);
+}
+
+void Adafruit_ST7789::allocFrame() {
+  free(frame);
+  frame = (uint16_t *)calloc((size_t)WIDTH * HEIGHT, sizeof(uint16_t));
+}
+
+void Adafruit_ST7789::init(uint16_t width, uint16_t height) {
+  WIDTH = (int16_t)width;
+  HEIGHT = (int16_t)height;
+  setRotation(0);
+  tiles = 0;
+  pixels = 0;
+}
+
+// A rotation change re-maps the glass, so start from a black panel
+void Adafruit_ST7789::setRotation(uint8_t r) {
+  Adafruit_GFX::setRotation(r);
+  allocFrame();
+}
+
+void Adafruit_ST7789::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  if (!frame || x < 0 || y < 0 || x >= _width || y >= _height) return;
+  frame[y * _width + x] = color;
+  pixels++;
+}
+
+void Adafruit_ST7789::drawRGBBitmap(int16_t x, int16_t y, uint16_t *pcolors, int16_t w, int16_t h) {
+  if (!frame) return;
+  tiles++;
+  int16_t x0 = x < 0 ? 0 : x, y0 = y < 0 ? 0 : y;
+  int16_t x1 = x + w > _width ? _width : (int16_t)(x + w);
+  int16_t y1 = y + h > _height ? _height : (int16_t)(y + h);
+  if (x0 >= x1 || y0 >= y1) return;
+  if (busHz) {
+    busBits += (uint64_t)w * (uint64_t)h * 16u;
+    uint64_t dueUs = busBits * 1000000u / busHz;
+    delayMicroseconds((uint32_t)(dueUs - busUs));
+    busUs = dueUs;
+  }
+  for (int16_t row = y0; row < y1; row++) {
+    memcpy(frame + row * _width + x0, pcolors + (row - y) * w + (x0 - x),
+           (size_t)(x1 - x0) * sizeof(uint16_t));
+  }
+  pixels += (uint32_t)(x1 - x0) * (uint32_t)(y1 - y0);
+}
+
+bool Adafruit_ST7789::savePPM(const char *path) const {
+  return frame && hostWritePPM(path, frame, _width, _height);
+}
@@ -5,3 +5,4 @@
 #include "pins.h"
 #include "types.h"
 #include "constants.h"
+#include "FastTrig.h"
@@ -2,6 +2,7 @@
 #pragma once
 
 #include <Arduino.h>
+#include "FixedMath.h"
 
 // -------------------- DISPLAY --------------------
 static const int CANVAS_W = 120;
@@ -10,10 +11,11 @@ static const int HUD_H = 28;
 
 // -------------------- ARRAY SIZES --------------------
 static const uint8_t MAX_POLLEN_CARRY = 8;
-static const int FLOWER_N = 7;
+static const int FLOWER_N = 32;                   // Live flowers across resident chunks
 static const int BELT_ITEM_N = 10;
-static const int TRAIL_MAX = 24;
+static const int PARTICLE_MAX = 320;
 static const int SCORE_POPUP_N = 6;
+static const int WASP_MAX = 48;
 
 // -------------------- TIMING --------------------
 static const uint32_t UNLOAD_TICK_MS = 100;
@@ -33,7 +35,20 @@ static const uint32_t RENDER_INTERVAL_ACTIVE_MS = 40;   // ~25 FPS
 static const uint32_t RENDER_INTERVAL_IDLE_MS = 80;     // ~12.5 FPS
 static const uint32_t TRAIL_SPAWN_INTERVAL_MS = 20;
 static const uint32_t MAX_DELTA_MS = 60;
-static const uint32_t LOOP_DELAY_MS = 2;
+
+// -------------------- SIMULATION --------------------
+// 250 Hz keeps the step a whole number of milliseconds, so sim timestamps
+// stay in the millis() domain used by every "...UntilMs" deadline.
+static const uint32_t SIM_HZ = 250;
+static const uint32_t SIM_STEP_MS = 1000 / SIM_HZ;
+static const uint32_t SIM_STEP_US = 1000000 / SIM_HZ;
+static const float SIM_DT_SEC = 1.0f / (float)SIM_HZ;
+static const fix16 SIM_DT = fxFromFloat(1.0f / (float)SIM_HZ);
+
+// Late latch: re-read the stick right before drawing and extrapolate the
+// bee to the moment the frame reaches the panel (render-only prediction)
+static const bool LATE_LATCH_ENABLED = true;
+static const uint32_t LATE_LATCH_MAX_LEAD_MS = 40;
 
 // -------------------- SURVIVAL --------------------
 static const float SURVIVAL_TIME_MAX = 15.0f;
@@ -43,13 +58,13 @@ static const float SURVIVAL_POLLEN_MULT_STEP = 0.55f;
 // -------------------- WORLD CONSTRAINTS --------------------
 static const float BOUNDARY_COMFORTABLE = 180.0f;
 
-// -------------------- MOVEMENT PHYSICS --------------------
-static const float SPRING_K_NORMAL = 32.0f;
-static const float SPRING_K_BOOST = 48.0f;
-static const float DAMPING_NORMAL = 12.0f;
-static const float DAMPING_BOOST = 16.0f;
-static const float CARRY_WEIGHT_SPRING_PENALTY = 0.22f;
-static const float CARRY_WEIGHT_DAMPING_PENALTY = 0.18f;
+// -------------------- MOVEMENT PHYSICS (Q16.16) --------------------
+static const fix16 SPRING_K_NORMAL = fxFromFloat(32.0f);
+static const fix16 SPRING_K_BOOST = fxFromFloat(48.0f);
+static const fix16 DAMPING_NORMAL = fxFromFloat(12.0f);
+static const fix16 DAMPING_BOOST = fxFromFloat(16.0f);
+static const fix16 CARRY_WEIGHT_SPRING_PENALTY = fxFromFloat(0.22f);
+static const fix16 CARRY_WEIGHT_DAMPING_PENALTY = fxFromFloat(0.18f);
 static const float BOOST_IMPULSE = 150.0f;
 static const uint32_t BOOST_DURATION_AUTO = 500;
 static const uint32_t BOOST_DURATION_MANUAL = 700;
@@ -60,30 +75,60 @@ static const uint32_t BOOST_COOLDOWN_MANUAL = 3500;
 static const float WING_SPEED_DIVISOR = 520.0f;
 static const float WING_HZ_MIN = 3.0f;
 static const float WING_HZ_RANGE = 14.0f;      // Hz = MIN + RANGE * speed
-static const float WING_PHASE_WRAP = 1000.0f;
 
-// -------------------- CAMERA --------------------
-static const float CAMERA_ZOOM_BOOST = 1.22f;
-static const float CAMERA_ZOOM_NORMAL = 1.0f;
-static const float CAMERA_ZOOM_LERP_SPEED = 7.0f;
-static const float CAMERA_SHAKE_MAGNITUDE = 6.5f;
+// -------------------- CAMERA (Q16.16) --------------------
+static const fix16 CAMERA_ZOOM_BOOST = fxFromFloat(1.22f);
+static const fix16 CAMERA_ZOOM_NORMAL = FX_ONE;
+static const fix16 CAMERA_ZOOM_LERP_SPEED = fxFromFloat(7.0f);
+static const fix16 CAMERA_SHAKE_MAGNITUDE = fxFromFloat(6.5f);
 static const uint32_t CAMERA_SHAKE_DURATION_MS = 180;
 static const float CAMERA_SHAKE_PHASE_MULT = 0.045f;
 static const float CAMERA_SHAKE_FREQ_X = 6.2f;
 static const float CAMERA_SHAKE_FREQ_Y = 7.4f;
 
-// -------------------- FLOWER SPAWNING --------------------
+// -------------------- FLOWER FIELD --------------------
 static const int FLOWER_RADIUS_MIN = 6;
 static const int FLOWER_RADIUS_MAX = 11;
-static const int FLOWER_SPAWN_NEAR_DIST_MIN = 90;
-static const int FLOWER_SPAWN_NEAR_DIST_MAX = 220;
-static const int FLOWER_COLLISION_DIST = 80;
-static const int FLOWER_SPAWN_ELSEWHERE_DIST_MIN = 60;
-static const int FLOWER_SPAWN_ELSEWHERE_MARGIN = 20;
-static const int FLOWER_BEE_AVOIDANCE_DIST = 150;
-static const int FLOWER_SPACING_ELSEWHERE = 120;
+static const uint32_t FLOWER_BLOOM_MS = 420;
+static const int32_t FLOWER_CHUNK_SIZE = 128;      // World units per streamed chunk
+static const int FLOWER_CHUNK_SLOTS = 8;           // Max sites in the per-chunk pattern
+static const int FLOWER_CHUNK_CACHE = 20;          // Resident chunks (LRU)
+static const int32_t FLOWER_SITE_SPACING = 56;     // Poisson-disk radius between sites
+static const int FLOWER_SITE_TRIES = 20;           // Candidates per active site before retiring it
+static const int FLOWER_SITE_WORK_PER_FRAME = 8;   // Candidates tested per idle frame
+static const float FLOWER_FIELD_TARGET = 7.0f;     // Mean flowers grown in the field
+static const int32_t FLOWER_FIELD_INNER = 60;      // Bare ring around the hive
+static const int FLOWER_FIELD_MARGIN = 20;         // Field ends this far inside the boundary
+static const int FLOWER_FIELD_MIN_SITES = 5;       // Sparser fields are rerolled
+static const int32_t FLOWER_STREAM_RADIUS = 180;   // Chunks kept resident around the bee
+static const uint32_t FLOWER_REGROW_MS = 8000;
+static const uint32_t FLOWER_REGROW_RETRY_MS = 1000;
+static const int32_t FLOWER_REGROW_BEE_DIST = 60;
+static const int32_t FLOWER_GRID_CELL = 64;       // World units per spatial hash cell
+static const int FLOWER_GRID_BUCKETS = 64;        // Hash chains (power of two)
 static const int BEE_HIT_RADIUS = 14;
 
+// -------------------- WASPS (HARD MODE) --------------------
+static const int WASP_COUNT_HARD = 12;
+static const int32_t WASP_GRID_CELL = 32;                 // Neighbour grid cell (world units)
+static const int WASP_GRID_BUCKETS = 64;
+static const int WASP_NEIGHBOR_MAX = 8;                   // Flockmates considered per wasp
+static const int32_t WASP_NEIGHBOR_RADIUS = 32;
+static const int32_t WASP_SEPARATION_RADIUS = 14;
+static const int32_t WASP_CHASE_RADIUS = 110;             // Closer than this, a wasp hunts the bee
+static const int32_t WASP_ORBIT_RADIUS = 30;              // Circling distance around a flower
+static const int32_t WASP_HIVE_CLEAR = 55;                // Wasps keep off the hive
+static const int32_t WASP_HIT_RADIUS = 4;
+static const fix16 WASP_SPEED_CHASE = fxFromFloat(75.0f);
+static const fix16 WASP_SPEED_PATROL = fxFromFloat(45.0f);
+static const fix16 WASP_STEER_GAIN = fxFromFloat(3.0f);   // 1/s toward the desired velocity
+static const fix16 WASP_COHESION = fxFromFloat(1.5f);     // 1/s^2
+static const fix16 WASP_ALIGNMENT = fxFromFloat(1.0f);    // 1/s
+static const fix16 WASP_SEPARATION = fxFromFloat(40.0f);  // 1/s^2
+static const fix16 WASP_HIVE_PUSH = fxFromFloat(12.0f);   // 1/s^2
+static const float WASP_STING_SECONDS = 1.5f;
+static const uint32_t WASP_STING_COOLDOWN_MS = 900;
+
 // -------------------- HIVE --------------------
 static const int HIVE_COLLECTION_RADIUS = 22;
 
@@ -95,10 +140,38 @@ static const int SCORE_POPUP_DRIFT_MAX = 10;
 static const int JOY_CENTER_DEFAULT = 512;
 static const int JOY_RANGE = 512;
 static const int JOY_DEADZONE = 35;
-static const int JOY_CALIBRATION_SAMPLES = 40;
-static const int JOY_CALIBRATION_DELAY_MS = 30;
+static const uint32_t JOY_CAL_SEED_TIMEOUT_US = 20000;   // First ADC window
+static const uint32_t JOY_REFINE_WINDOW_MS = 5000;       // Background refinement after boot
+static const int JOY_REFINE_SHIFT = 6;                   // Resting-center IIR (~128 ms at 500 Hz)
+static const int JOY_CAL_SAVE_THRESHOLD = 3;             // Counts of drift before rewriting flash
+static const int JOY_CAL_EEPROM_SIZE = 64;
 static const float JOY_DOWN_BOOST = 1.20f;
 
+// -------------------- BUTTON --------------------
+static const uint32_t BUTTON_DEBOUNCE_US = 5000;
+static const uint32_t BUTTON_PRESS_MAX_AGE_US = 300000;   // Older unconsumed presses are dropped
+static const uint32_t BUTTON_QUEUE_N = 16;                // Power of two
+
+// -------------------- ADC STREAM --------------------
+// Free-running round robin over both axes; each axis sees half the rate.
+static const uint32_t ADC_SAMPLE_RATE_HZ = 8000;
+static const int ADC_RING_BITS = 6;          // 64 samples = 32 X/Y pairs
+static const int ADC_OVERSAMPLE = 8;         // Pairs averaged per read (2 ms)
+static const int ADC_IIR_PAIRS = 16;         // IIR time constant, in pairs (4 ms)
+
+// -------------------- AUDIO --------------------
+static const uint32_t AUDIO_PERIOD_US = 1000;       // 1 kHz motion publish and synth service
+static const uint32_t AUDIO_EVENT_QUEUE_N = 32;     // Power of two
+
+// -------------------- TRACE --------------------
+// Input trace on the device (trace.cpp): record streams the session out
+// over USB serial, replay plays include/trace_data.h back. Host tools pick
+// their own mode at run time.
+static const bool TRACE_DEVICE_RECORD = false;
+static const bool TRACE_DEVICE_REPLAY = false;
+static const uint32_t TRACE_BUF_N = 2048;           // Record buffer, drained from render spare time
+static const uint32_t TRACE_MAGIC = 0x31545A50u;   // "PZT1"
+
 // -------------------- RGB565 HELPER --------------------
 static inline uint16_t rgb565(uint8_t r, uint8_t g, uint8_t b) {
   return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
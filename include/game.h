@@ -2,54 +2,75 @@
 #pragma once
 
 #include "config.h"
+#include "pool.h"
+#include "spatial_hash.h"
 #include <Adafruit_GFX.h>
 #include <Adafruit_ST7789.h>
 
 // ==================== SHARED GLOBALS (state.cpp) ====================
 extern Adafruit_ST7789 tft;
 extern GFXcanvas16 canvas;
+extern LatencyStats latchToPresent;   // Late-latched stick sample -> frame on panel
+extern BootProfile bootProfile;       // Setup phase timings, first frame and first input
 
 // ==================== INPUT (input.cpp) ====================
 extern int joyCenterX, joyCenterY;
 extern int joyMinY, joyMaxY;
-extern bool btnPrev;
+extern LatencyStats clickToResponse;   // Button press (ISR timestamp) -> consumed by the sim
 
 int readJoyX();
 int readJoyY();
 bool joyPressedRaw();
 int applyDeadzone(int v, int center, int dz);
-void calibrateJoystick();
+bool beginJoystickCalibration(uint32_t nowMs);
+void saveJoystickCalibration();
 void readNormalizedJoystick(float &nx, float &ny, int &rawDx, int &rawDy);
-bool readButtonEdge();
-void resetButtonState();
+void buttonBegin();
+bool buttonPollEvent(ButtonEvent &ev);
+
+// Latched input, refreshed by the input task and consumed by the simulation
+extern JoystickSample joyLatest;
+void sampleInput();
+void latchJoystick();
+void injectJoystick(int rawX, int rawY);
+bool consumeClick();
+
+// ==================== ADC STREAM (adcstream.cpp) ====================
+void adcStreamBegin();
+bool adcStreamRead(JoyAxes &out);
+#if !defined(ARDUINO_ARCH_RP2040)
+void adcStreamSetSource(AdcSampleSource src);
+#endif
 
 // ==================== BEE (bee.cpp) ====================
-extern float beeWX, beeWY;
-extern float beeVX, beeVY;
-extern float wingPhase;
+extern fix16 beeWX, beeWY;
+extern fix16 beeVX, beeVY;
+extern uint32_t wingPhase;    // Binary angle accumulator (65536 per flap)
 extern float wingSpeed;
 extern uint32_t boostActiveUntilMs;
 extern uint32_t boostCooldownUntilMs;
 
 bool isBoosting(uint32_t nowMs);
 bool isBoostOnCooldown(uint32_t nowMs);
+bool beeTouches(int32_t wx, int32_t wy, int32_t r);
 void triggerAutoBoost(uint32_t nowMs);
 void triggerManualBoost(uint32_t nowMs);
-void updateBeePhysics(float nx, float ny, int rawDx, int rawDy, float dt, bool boosting);
+void updateBeePhysics(float nx, float ny, int rawDx, int rawDy, fix16 dt, bool boosting);
+void predictBeePosition(const JoystickSample &joy, fix16 lead, bool boosting, fix16 &px, fix16 &py);
 void updateWingAnimation(float dt);
 void resetBee();
 void stopBeeMovement();
-float getBeeSpeed();
+fix16 getBeeSpeed();   // World units/s
 
 // ==================== FLOWERS (flowers.cpp) ====================
-extern Flower flowers[FLOWER_N];
-extern uint32_t flowerBornMs[FLOWER_N];
-
-void initFlowerStyle(Flower &f);
-void spawnFlowerAt(int i, int32_t wx, int32_t wy);
-void spawnFlowerNearOrigin(int i);
-void spawnFlowerElsewhere(int i);
-void initFlowers();
+extern Pool<Flower, FLOWER_N> flowers;
+// World-space index of live flowers, keyed by pool slot
+extern SpatialHash<FLOWER_N, FLOWER_GRID_BUCKETS, FLOWER_GRID_CELL> flowerGrid;
+
+void initFlowerStyle(Flower &f, uint32_t seed);
+void initFlowers(uint32_t nowMs);
+void updateFlowerField(uint32_t nowMs);
+void prepareFlowerSites();
 bool tryCollectPollen(uint32_t nowMs);
 bool findNearestFlower(int32_t &outWX, int32_t &outWY);
 
@@ -60,11 +81,9 @@ extern uint8_t unloadTotal;
 extern uint32_t unloadNextMs;
 extern uint8_t depositsTowardBoost;
 extern uint8_t boostCharge;
-extern BeltItem beltItems[BELT_ITEM_N];
+extern Pool<BeltItem, BELT_ITEM_N> beltItems;
 
 void spawnBeltItem(uint32_t nowMs);
-void updateBeltLifetimes(uint32_t nowMs);
-bool anyBeltAlive();
 void beginUnload(uint32_t nowMs);
 void updateUnload(uint32_t nowMs);
 void tryStoreAtHive(uint32_t nowMs);
@@ -77,37 +96,53 @@ extern int32_t radarTargetWX, radarTargetWY;
 extern bool radarToHive;
 
 void beginRadarPing(uint32_t nowMs);
-void updateRadar(uint32_t nowMs);
 void resetRadar();
 
 // ==================== VFX (vfx.cpp) ====================
-extern TrailParticle trail[TRAIL_MAX];
-extern int trailNextIdx;
-extern ScorePopup scorePopups[SCORE_POPUP_N];
-extern float cameraZoom;
-extern float cameraShakeX, cameraShakeY;
+extern Pool<ScorePopup, SCORE_POPUP_N> scorePopups;
+extern fix16 cameraZoom;
+extern fix16 cameraShakeX, cameraShakeY;
 extern uint32_t cameraShakeUntilMs;
 extern uint32_t cameraShakeDurationMs;
-extern float cameraShakeMagnitude;
+extern fix16 cameraShakeMagnitude;
 extern uint32_t hivePulseUntilMs;
+extern CameraTransform cam;
 
 int beeScreenCX();
 int beeScreenCY();
-void triggerCameraShake(uint32_t nowMs, float magnitude, uint32_t durationMs);
-void updateCamera(float dt, bool boosting, uint32_t nowMs);
+void triggerCameraShake(uint32_t nowMs, fix16 magnitude, uint32_t durationMs);
+void updateCamera(fix16 dt, bool boosting, uint32_t nowMs);
+void settleCamera(fix16 dt);
 void resetCamera();
+void captureInterpolationState();
+void interpolateBeeVelocity(fix16 alpha, fix16 &vx, fix16 &vy);
+void updateCameraTransform(fix16 alpha);
+void updateCameraTransformAt(fix16 originX, fix16 originY, fix16 aheadSec);
 void worldToScreen(int32_t wx, int32_t wy, int &sx, int &sy);
-void worldToScreenF(float wx, float wy, int &sx, int &sy);
+void worldToScreenFx(fix16 wx, fix16 wy, int &sx, int &sy);
 uint32_t worldCellSeed(int32_t cx, int32_t cy, uint32_t salt);
-void spawnTrailParticle(float wx, float wy, float speedN, uint32_t nowMs);
-void updateTrailParticles(uint32_t nowMs);
-bool anyTrailAlive();
 void spawnScorePopup(uint32_t nowMs, uint8_t value, int sx, int sy);
-void updateScorePopups(uint32_t nowMs);
-bool anyScorePopupAlive();
 void triggerHivePulse(uint32_t nowMs);
 void resetVFX();
 
+// ==================== PARTICLES (particles.cpp) ====================
+void resetParticles();
+int particleCount();
+void emitParticles(EmitterKind kind, fix16 wx, fix16 wy, fix16 vx, fix16 vy, uint8_t variant, int count);
+void updateParticles();
+void projectParticles();
+void drawParticles(Adafruit_GFX &g, int ox, int oy);
+
+// ==================== WASPS (wasps.cpp) ====================
+extern bool waspsEnabled;     // Hard mode: chosen on the game-over screen
+
+void resetWasps();
+void spawnWasps(int count);
+int waspCount();
+void updateWasps(fix16 dt, uint32_t nowMs);
+void projectWasps();
+void drawWasps(Adafruit_GFX &g, int ox, int oy, uint32_t nowMs);
+
 // ==================== SURVIVAL (survival.cpp) ====================
 extern uint8_t pollenCount;
 extern uint16_t score;
@@ -122,5 +157,70 @@ void updateSurvivalTimer(float dt, uint32_t nowMs);
 void addSurvivalTime(uint32_t nowMs, float amount);
 void resetSurvival();
 
+// ==================== TIMERS (timers.cpp) ====================
+// Deadline wheel for one-shot expiries. Keep-awake timers hold the render
+// task at its active cadence until they fire.
+void resetTimers(uint32_t nowMs);
+void timerArm(TimerTag tag, uint16_t arg, uint32_t atMs, TimerFn fn, bool keepsAwake);
+void timerCancel(TimerTag tag, uint16_t arg);
+void processTimers(uint32_t nowMs);
+uint32_t timerNowMs();
+bool timerNextDeadline(uint32_t nowMs, uint32_t &atMs);
+bool timersKeepAwake();
+
+// ==================== SCHEDULER (scheduler.cpp) ====================
+static const int SCHED_MAX_TASKS = 8;
+
+int schedulerAddTask(const char *name, TaskFn fn, uint32_t periodUs, uint8_t priority,
+                     uint32_t nowUs);
+void schedulerSetPeriod(int id, uint32_t periodUs);
+void schedulerRunOnce();
+int schedulerTaskCount();
+const char *schedulerTaskName(int id);
+const TaskStats &schedulerStats(int id);
+void schedulerResetStats();
+void latencyRecord(LatencyStats &s, uint32_t us);
+
+// ==================== AUDIO (audio.cpp) ====================
+// The synth runs on its own core (a thread on host builds). Everything
+// below except audioCoreSetup/audioCoreLoop is called from the game core.
+enum SndMode : uint8_t;
+struct SoundQueueStats;
+
+extern LatencyStats audioEventLatency;   // Post -> applied on the audio core
+
+void audioBegin();
+void audioCoreSetup();
+void audioCoreLoop();
+#if !defined(ARDUINO_ARCH_RP2040)
+void audioEnd();
+#endif
+void audioPost(SndMode mode);
+void audioUnloadTone(uint16_t freq, uint16_t durationMs);
+void audioUnloadDone();
+void audioStopAll();
+void audioResetMotion();
+void audioPublishMotion(const AudioMotion &m);
+uint32_t audioEventsDropped();
+const SoundQueueStats &audioQueueStats();
+
+// ==================== TRACE (trace.cpp) ====================
+// Per-step input trace: the sim clock, the stick and calibration it read
+// and whether it took a click, plus a state hash. Replay feeds these back
+// through the input layer and flags the first step whose hash differs.
+void traceBegin();
+void traceRecordBegin(TraceSink sink);
+bool traceReplayBegin(const uint8_t *data, uint32_t len);
+void traceBoot(uint32_t &clockMs);
+uint32_t traceStepBegin(uint32_t nowMs);
+void traceStepEnd();
+void traceFlush();
+bool traceReplaying();
+bool traceReplayClick();
+void traceRecordClick();
+uint32_t traceStateHash();
+const TraceStatus &traceStatus();
+
 // ==================== GRAPHICS (graphics.cpp) ====================
+// Draws with the current camera transform; callers set it up first
 void renderFrame(uint32_t nowMs);
@@ -0,0 +1,106 @@
+// Pixel Buzz Box - Entity Pool (Fixed Capacity, Alive Bitmask)
+#pragma once
+
+#include <stdint.h>
+
+// Fixed-capacity storage for short-lived entities. Liveness is a bitmask,
+// so the live count is O(1), a free slot is found one 32-bit word at a
+// time with count-trailing-zeros, and iteration skips dead slots without
+// touching them. Each acquire stamps the slot so the oldest live entry can
+// be evicted when the pool is full.
+//
+//   for (int i = pool.first(); i >= 0; i = pool.next(i)) { ... pool[i] ... }
+template <typename T, int N>
+class Pool {
+  static_assert(N > 0, "Pool capacity must be positive");
+
+public:
+  static const int CAPACITY = N;
+
+  Pool() { clear(); }
+
+  T &operator[](int i) { return items[i]; }
+  const T &operator[](int i) const { return items[i]; }
+
+  bool alive(int i) const { return (mask[i >> 5] >> (i & 31)) & 1u; }
+  int count() const { return live; }
+  bool empty() const { return live == 0; }
+  bool full() const { return live == N; }
+
+  // Lowest free slot, now live; -1 when full. Contents are left as they
+  // were, the caller initializes them.
+  int acquire() {
+    for (int w = 0; w < WORDS; w++) {
+      uint32_t freeBits = ~mask[w] & wordBits(w);
+      if (freeBits) {
+        int i = (w << 5) + __builtin_ctz(freeBits);
+        mask[w] |= 1u << (i & 31);
+        stamp[i] = ++clock;
+        live++;
+        return i;
+      }
+    }
+    return -1;
+  }
+
+  // Lowest free slot, or the oldest live entry (restamped) when full.
+  int acquireOrEvict() {
+    int i = acquire();
+    if (i >= 0) return i;
+    i = oldest();
+    stamp[i] = ++clock;
+    return i;
+  }
+
+  void release(int i) {
+    uint32_t bit = 1u << (i & 31);
+    if (!(mask[i >> 5] & bit)) return;
+    mask[i >> 5] &= ~bit;
+    live--;
+  }
+
+  void clear() {
+    for (int w = 0; w < WORDS; w++) mask[w] = 0;
+    live = 0;
+    clock = 0;
+  }
+
+  // Live entry acquired longest ago; -1 when empty.
+  int oldest() const {
+    int best = -1;
+    for (int i = first(); i >= 0; i = next(i)) {
+      if (best < 0 || (int32_t)(stamp[i] - stamp[best]) < 0) best = i;
+    }
+    return best;
+  }
+
+  // Live iteration in slot order; -1 ends the walk.
+  int first() const { return next(-1); }
+
+  int next(int i) const {
+    i++;
+    if (i >= N) return -1;
+    int w = i >> 5;
+    uint32_t bits = mask[w] & (~0u << (i & 31));
+    while (!bits) {
+      if (++w >= WORDS) return -1;
+      bits = mask[w];
+    }
+    return (w << 5) + __builtin_ctz(bits);
+  }
+
+private:
+  static const int WORDS = (N + 31) / 32;
+
+  // Valid slot bits of word w (the last word may be partial)
+  static uint32_t wordBits(int w) {
+    int rem = N - (w << 5);
+    return (rem >= 32) ? 0xFFFFFFFFu : ((1u << rem) - 1u);
+  }
+
+  T items[N];
+  uint32_t mask[WORDS];
+  uint32_t stamp[N];
+  uint32_t clock;
+  int live;
+};
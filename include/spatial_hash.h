@@ -0,0 +1,206 @@
+// Pixel Buzz Box - Spatial Hash (Uniform World Grid)
+#pragma once
+
+#include <stdint.h>
+#include "FixedMath.h"
+
+// Points keyed by a caller-owned id in [0, N), bucketed by the world cell
+// they fall in. Cells are CELL world units square; cell coordinates hash
+// into BUCKETS chains (power of two), so the world is unbounded while
+// memory stays fixed. Insert and remove are O(1) (doubly linked chains
+// plus a packed list of live ids); queries only walk the cells overlapping
+// the query shape, unless a pass over the packed list is cheaper: a cell
+// visit costs about SCAN_PER_CELL point checks (tools/grid_bench), so a
+// query over no more points than that many per cell it spans scans.
+template <int N, int BUCKETS, int32_t CELL>
+class SpatialHash {
+  static_assert(N > 0 && N < 32767, "SpatialHash ids must fit in int16_t");
+  static_assert((BUCKETS & (BUCKETS - 1)) == 0, "SpatialHash bucket count must be a power of two");
+
+public:
+  static const int16_t NONE = -1;
+  static const int SCAN_PER_CELL = 2;
+
+  SpatialHash() { clear(); }
+
+  void clear() {
+    for (int b = 0; b < BUCKETS; b++) head[b] = NONE;
+    for (int i = 0; i < N; i++) bucketOf[i] = NONE;
+    total = 0;
+  }
+
+  int count() const { return total; }
+  bool contains(int id) const { return bucketOf[id] != NONE; }
+
+  void insert(int id, int32_t x, int32_t y) {
+    if (contains(id)) remove(id);
+    px[id] = x;
+    py[id] = y;
+    cx[id] = floorDivi(x, CELL);
+    cy[id] = floorDivi(y, CELL);
+    int16_t b = bucketFor(cx[id], cy[id]);
+    bucketOf[id] = b;
+    prev[id] = NONE;
+    next[id] = head[b];
+    if (head[b] != NONE) prev[head[b]] = (int16_t)id;
+    head[b] = (int16_t)id;
+    liveAt[id] = (int16_t)total;
+    live[total++] = (int16_t)id;
+  }
+
+  void remove(int id) {
+    int16_t b = bucketOf[id];
+    if (b == NONE) return;
+    if (prev[id] != NONE) next[prev[id]] = next[id];
+    else head[b] = next[id];
+    if (next[id] != NONE) prev[next[id]] = prev[id];
+    bucketOf[id] = NONE;
+    int16_t last = live[--total];
+    live[liveAt[id]] = last;
+    liveAt[last] = liveAt[id];
+  }
+
+  // Ids inside the rectangle [x0, x1] x [y0, y1]; returns how many were
+  // written (at most maxOut).
+  int queryRect(int32_t x0, int32_t y0, int32_t x1, int32_t y1, int16_t *out, int maxOut) const {
+    int n = 0;
+    int32_t c0x = floorDivi(x0, CELL), c1x = floorDivi(x1, CELL);
+    int32_t c0y = floorDivi(y0, CELL), c1y = floorDivi(y1, CELL);
+    if (scanCheaper(c0x, c0y, c1x, c1y)) {
+      for (int k = 0; k < total && n < maxOut; k++) {
+        int16_t i = live[k];
+        if (px[i] >= x0 && px[i] <= x1 && py[i] >= y0 && py[i] <= y1) out[n++] = i;
+      }
+      return n;
+    }
+    for (int32_t gy = c0y; gy <= c1y; gy++) {
+      for (int32_t gx = c0x; gx <= c1x; gx++) {
+        for (int16_t i = head[bucketFor(gx, gy)]; i != NONE; i = next[i]) {
+          if (cx[i] != gx || cy[i] != gy) continue;   // Hash neighbour
+          if (px[i] < x0 || px[i] > x1 || py[i] < y0 || py[i] > y1) continue;
+          if (n >= maxOut) return n;
+          out[n++] = i;
+        }
+      }
+    }
+    return n;
+  }
+
+  // Ids within distance r of (x, y), inclusive.
+  int queryRadius(int32_t x, int32_t y, int32_t r, int16_t *out, int maxOut) const {
+    int n = 0;
+    int64_t r2 = (int64_t)r * r;
+    int32_t c0x = floorDivi(x - r, CELL), c1x = floorDivi(x + r, CELL);
+    int32_t c0y = floorDivi(y - r, CELL), c1y = floorDivi(y + r, CELL);
+    if (scanCheaper(c0x, c0y, c1x, c1y)) {
+      for (int k = 0; k < total && n < maxOut; k++) {
+        if (dist2(live[k], x, y) <= r2) out[n++] = live[k];
+      }
+      return n;
+    }
+    for (int32_t gy = c0y; gy <= c1y; gy++) {
+      for (int32_t gx = c0x; gx <= c1x; gx++) {
+        for (int16_t i = head[bucketFor(gx, gy)]; i != NONE; i = next[i]) {
+          if (cx[i] != gx || cy[i] != gy) continue;
+          if (dist2(i, x, y) > r2) continue;
+          if (n >= maxOut) return n;
+          out[n++] = i;
+        }
+      }
+    }
+    return n;
+  }
+
+  // True if any point other than `ignore` lies closer than r to (x, y).
+  bool anyWithin(int32_t x, int32_t y, int32_t r, int ignore = NONE) const {
+    int64_t r2 = (int64_t)r * r;
+    int32_t c0x = floorDivi(x - r, CELL), c1x = floorDivi(x + r, CELL);
+    int32_t c0y = floorDivi(y - r, CELL), c1y = floorDivi(y + r, CELL);
+    if (scanCheaper(c0x, c0y, c1x, c1y)) {
+      for (int k = 0; k < total; k++) {
+        if (live[k] != ignore && dist2(live[k], x, y) < r2) return true;
+      }
+      return false;
+    }
+    for (int32_t gy = c0y; gy <= c1y; gy++) {
+      for (int32_t gx = c0x; gx <= c1x; gx++) {
+        for (int16_t i = head[bucketFor(gx, gy)]; i != NONE; i = next[i]) {
+          if (i == ignore || cx[i] != gx || cy[i] != gy) continue;
+          if (dist2(i, x, y) < r2) return true;
+        }
+      }
+    }
+    return false;
+  }
+
+  // Closest id to (x, y), or NONE when empty. Searches square rings of
+  // cells outward and stops once no unvisited cell can beat the best hit
+  // (at the earliest after ring 2, 5 x 5 cells); a sparse grid where the
+  // rings would outgrow the table is scanned whole.
+  int nearest(int32_t x, int32_t y) const {
+    if (total == 0) return NONE;
+    int32_t ox = floorDivi(x, CELL), oy = floorDivi(y, CELL);
+    if (scanCheaper(ox - 2, oy - 2, ox + 2, oy + 2)) return nearestByScan(x, y);
+    int best = NONE;
+    int64_t bestD2 = 0;
+    int seen = 0;
+
+    for (int32_t ring = 0; seen < total; ring++) {
+      // Every point in ring k is at least (k - 1) * CELL away
+      if (best != NONE && ring > 0) {
+        int64_t minD = (int64_t)(ring - 1) * CELL;
+        if (minD * minD > bestD2) break;
+      }
+      if ((2 * ring + 1) * (2 * ring + 1) > BUCKETS) return nearestByScan(x, y);
+      for (int32_t gy = oy - ring; gy <= oy + ring; gy++) {
+        bool edgeRow = (gy == oy - ring || gy == oy + ring);
+        int32_t stepX = edgeRow ? 1 : 2 * ring;
+        for (int32_t gx = ox - ring; gx <= ox + ring; gx += (stepX > 0 ? stepX : 1)) {
+          for (int16_t i = head[bucketFor(gx, gy)]; i != NONE; i = next[i]) {
+            if (cx[i] != gx || cy[i] != gy) continue;
+            seen++;
+            int64_t d2 = dist2(i, x, y);
+            if (best == NONE || d2 < bestD2) { best = i; bestD2 = d2; }
+          }
+        }
+      }
+    }
+    return best;
+  }
+
+private:
+  bool scanCheaper(int32_t c0x, int32_t c0y, int32_t c1x, int32_t c1y) const {
+    int64_t cells = (int64_t)(c1x - c0x + 1) * (c1y - c0y + 1);
+    return (int64_t)total <= cells * SCAN_PER_CELL;
+  }
+
+  int nearestByScan(int32_t x, int32_t y) const {
+    int best = NONE;
+    int64_t bestD2 = 0;
+    for (int k = 0; k < total; k++) {
+      int64_t d2 = dist2(live[k], x, y);
+      if (best == NONE || d2 < bestD2) { best = live[k]; bestD2 = d2; }
+    }
+    return best;
+  }
+
+  static int16_t bucketFor(int32_t gx, int32_t gy) {
+    uint32_t h = (uint32_t)gx * 73856093u ^ (uint32_t)gy * 19349663u;
+    h ^= h >> 13;
+    return (int16_t)(h & (BUCKETS - 1));
+  }
+
+  int64_t dist2(int i, int32_t x, int32_t y) const {
+    int64_t dx = (int64_t)px[i] - x;
+    int64_t dy = (int64_t)py[i] - y;
+    return dx * dx + dy * dy;
+  }
+
+  int32_t px[N], py[N];
+  int32_t cx[N], cy[N];
+  int16_t next[N], prev[N];
+  int16_t bucketOf[N];
+  int16_t live[N], liveAt[N];   // Packed live ids, and each id's place in it
+  int16_t head[BUCKETS];
+  int total;
+};
@@ -2,28 +2,32 @@
 #pragma once
 
 #include <Arduino.h>
+#include "FixedMath.h"
+#include "constants.h"
 
 // -------------------- GAME ENTITIES --------------------
+// Liveness lives in the owning Pool (pool.h), not in the entities.
 struct Flower {
   int32_t wx, wy;       // World position
-  uint8_t alive;
+  uint32_t bornMs;      // Spawn time (bloom animation)
   uint8_t r;            // Radius
   uint16_t petal;       // Petal color
   uint16_t petalLo;     // Darker petal color
   uint16_t center;      // Center color
+  uint8_t chunk;        // Owning chunk cache entry
+  uint8_t slot;         // Site within the chunk
 };
 
-struct BeltItem {
-  uint32_t bornMs;
-  uint8_t alive;
+struct FlowerChunk {
+  int32_t cx, cy;       // Chunk coordinates (FLOWER_CHUNK_SIZE units)
+  uint32_t lastUsed;    // Stream pass that last needed it (LRU)
+  uint8_t harvested;    // Bit per site, picked and not yet regrown
+  bool used;
+  int8_t flower[FLOWER_CHUNK_SLOTS];   // Pool slot per site, -1 if bare
 };
 
-struct TrailParticle {
-  float wx, wy;         // World position
+struct BeltItem {
   uint32_t bornMs;
-  uint8_t alive;
-  uint8_t variant;
-  float speedN;         // Normalized speed
 };
 
 struct ScorePopup {
@@ -32,5 +36,145 @@ struct ScorePopup {
   int16_t baseSY;       // Screen Y
   int8_t driftX;
   uint8_t value;
-  uint8_t alive;
+};
+
+// -------------------- PARTICLES --------------------
+enum EmitterKind : uint8_t {
+  EMIT_BOOST_TRAIL,       // variant = speed band 0..3
+  EMIT_POLLEN_SPARKLE,
+  EMIT_BLOOM_SPARK,
+  EMIT_HIVE_DEBRIS,
+  EMITTER_N
+};
+
+// -------------------- INPUT --------------------
+struct JoystickSample {
+  float nx, ny;         // Normalized stick position [-1, 1]
+  int rawDx, rawDy;     // Deadzoned offsets from center (0 = neutral)
+  int16_t axisX, axisY; // Filtered axes the above came from (traced)
+  uint32_t sampledUs;   // Capture time of the axes (ADC stream window midpoint)
+};
+
+// Debounced button edge, timestamped in the pin-change interrupt
+struct ButtonEvent {
+  uint32_t us;
+  uint8_t pressed;      // 1 = press, 0 = release
+};
+
+// Filtered axes from the ADC stream, on the 10-bit analogRead scale
+struct JoyAxes {
+  int16_t x, y;
+  uint32_t sampledUs;   // Midpoint of the averaged sample window
+};
+
+// Host builds: raw 12-bit sample for ADC input at time tUs
+typedef uint16_t (*AdcSampleSource)(uint8_t input, uint32_t tUs);
+
+// -------------------- BOOT --------------------
+enum BootPhase : uint8_t {
+  BOOT_PHASE_HARDWARE,      // Reset -> pins, button, audio, ADC stream up
+  BOOT_PHASE_DISPLAY,       // SPI + panel init
+  BOOT_PHASE_CALIBRATION,   // Stored or seeded joystick center
+  BOOT_PHASE_WORLD,         // Domain resets
+  BOOT_PHASE_FIRST_FRAME,   // First full frame pushed
+  BOOT_PHASE_FLOWERS,       // Initial flower placement
+  BOOT_PHASE_N
+};
+
+struct BootProfile {
+  uint32_t phaseUs[BOOT_PHASE_N];
+  uint32_t firstFrameUs;        // micros() since reset when the first frame was on the panel
+  uint32_t firstInputUs;        // micros() since reset of the first calibrated stick sample
+  bool calibrationFromFlash;
+};
+
+// -------------------- SCHEDULER --------------------
+typedef void (*TaskFn)(uint32_t nowUs);
+
+struct TaskStats {
+  uint32_t runs;
+  uint32_t overruns;        // Runs that started after their deadline
+  uint32_t worstLatencyUs;  // Release -> start
+  uint32_t worstRunUs;      // Start -> finish
+};
+
+// Rolling latency of a measured path (e.g. input latch -> frame presented)
+struct LatencyStats {
+  uint32_t count;
+  uint32_t lastUs;
+  uint32_t worstUs;
+  uint32_t totalUs;         // Sum for the mean; reset before it can wrap
+};
+
+// -------------------- TIMERS --------------------
+typedef void (*TimerFn)(uint16_t arg);
+
+// Owner of a deadline; (tag, arg) identifies one pending timer, where arg
+// is the item index for per-item lifetimes.
+enum TimerTag : uint8_t {
+  TIMER_BOOST,
+  TIMER_CAMERA_SHAKE,
+  TIMER_RADAR,
+  TIMER_HIVE_PULSE,
+  TIMER_SURVIVAL_FLASH,
+  TIMER_SCORE_POPUP,
+  TIMER_BELT_ITEM,
+  TIMER_FLOWER_REGROW
+};
+
+// -------------------- AUDIO --------------------
+// Game -> synth commands, applied in order on the audio core
+enum AudioEventKind : uint8_t {
+  AUDIO_EV_POST,            // Queue effect `mode` (SndMode)
+  AUDIO_EV_UNLOAD_TONE,     // One unload chirp at freq for durationMs
+  AUDIO_EV_UNLOAD_DONE,     // Glide the buzz back from the last chirp
+  AUDIO_EV_STOP_ALL,
+  AUDIO_EV_RESET_MOTION     // New round: forget heading, smoothing, envelope
+};
+
+struct AudioEvent {
+  uint32_t us;              // micros() when posted, for ring latency
+  uint8_t kind;
+  uint8_t mode;
+  uint16_t freq;
+  uint16_t durationMs;
+};
+
+// Latest bee motion for the ambient model; only the newest value matters
+struct AudioMotion {
+  fix16 wingSpeed;
+  fix16 vx, vy, speed;
+  bool active;              // False while unloading or game over: buzz left as is
+};
+
+// -------------------- TRACE --------------------
+enum TraceMode : uint8_t {
+  TRACE_OFF,
+  TRACE_RECORD,
+  TRACE_REPLAY
+};
+
+// Receives recorded trace bytes in order (serial port, file)
+typedef void (*TraceSink)(const uint8_t *data, uint32_t len);
+
+struct TraceStatus {
+  TraceMode mode;
+  bool diverged;            // Replay: some step's state hash differed
+  bool finished;            // Replay: trace exhausted, live input resumed
+  uint32_t steps;           // Steps recorded or replayed
+  uint32_t divergedStep;    // Replay: first step whose hash differed
+  uint32_t bytes;           // Trace bytes written or consumed
+  uint32_t stallFlushes;    // Record: buffer filled mid-step and was flushed there
+};
+
+// -------------------- CAMERA --------------------
+// World->screen mapping, rebuilt once per frame so per-object transforms
+// are a subtract and a multiply with no divides or display queries.
+struct CameraTransform {
+  fix16 originX, originY;   // World point pinned to the screen anchor (bee)
+  fix16 zoom;               // World->screen scale
+  fix16 invZoom;            // Screen->world scale (1 / zoom)
+  int16_t centerX;          // Screen anchor X (includes shake)
+  int16_t centerY;          // Screen anchor Y (includes shake)
+  fix16 aheadSec;           // Frame time past the latest sim step (< 0: between the last two)
 };
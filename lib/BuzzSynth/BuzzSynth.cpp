@@ -2,6 +2,14 @@
 #include "BuzzSynth.h"
 #include <math.h>
 
+#if defined(ARDUINO_ARCH_RP2040)
+#include <hardware/pwm.h>
+#include <hardware/dma.h>
+#include <hardware/irq.h>
+#include <hardware/clocks.h>
+#include <hardware/gpio.h>
+#endif
+
 // Hash function for jitter
 static uint32_t hash32(uint32_t x) {
   x ^= x >> 16;
@@ -12,20 +20,214 @@ static uint32_t hash32(uint32_t x) {
   return x;
 }
 
+// -------------------- WAVETABLES --------------------
+// One cycle in 256 steps, indexed by the top byte of the phase
+static int8_t sineTable[256];
+static int8_t buzzTable[256];
+static bool tablesBuilt = false;
+
+static void buildTables() {
+  for (int i = 0; i < 256; i++) {
+    float a = (float)i * (6.2831853f / 256.0f);
+    sineTable[i] = (int8_t)lroundf(sinf(a) * 127.0f);
+    // Band-limited saw: harmonics 1..8 at 1/k, normalised to the peak
+    float saw = 0.0f;
+    for (int k = 1; k <= 8; k++) saw += sinf(a * k) / (float)k;
+    buzzTable[i] = (int8_t)lroundf(saw * (127.0f / 1.75f));
+  }
+  tablesBuilt = true;
+}
+
+// -------------------- OUTPUT STAGE --------------------
+// Phase step for 1 Hz, 2^32 / rate rounded (0.0002% pitch error at 22.05 kHz)
+static const uint32_t PHASE_PER_HZ = (uint32_t)((4294967296ull + SYNTH_SAMPLE_RATE / 2) / SYNTH_SAMPLE_RATE);
+static const uint32_t SAMPLES_PER_MS = SYNTH_SAMPLE_RATE / 1000;
+static const uint8_t EVENT_VOLUME = 220;
+static const uint8_t AMBIENT_VOLUME = 150;
+static const uint8_t SWISH_VOLUME = 70;
+
+#if defined(ARDUINO_ARCH_RP2040)
+// Two blocks ping-pong between chained channels: while one plays, the
+// interrupt refills the other. Samples are 16-bit so a single write
+// reaches both compare halves of the slice.
+static uint16_t dmaBlock[2][SYNTH_BLOCK];
+static int dmaChan[2] = { -1, -1 };
+static BuzzSynth *activeSynth = nullptr;
+
+static void dmaIrq() {
+  uint8_t scratch[SYNTH_BLOCK];
+  for (int b = 0; b < 2; b++) {
+    uint32_t mask = 1u << dmaChan[b];
+    if (!(dma_hw->ints1 & mask)) continue;
+    dma_hw->ints1 = mask;
+    activeSynth->renderSamples(scratch, SYNTH_BLOCK);
+    for (int i = 0; i < SYNTH_BLOCK; i++) dmaBlock[b][i] = scratch[i];
+    dma_channel_set_read_addr((uint)dmaChan[b], dmaBlock[b], false);
+  }
+}
+
+static void startOutput(int pin) {
+  // Carrier at sys_clk / 256 (~488 kHz), far above what the piezo follows
+  gpio_set_function((uint)pin, GPIO_FUNC_PWM);
+  uint slice = pwm_gpio_to_slice_num((uint)pin);
+  pwm_config pc = pwm_get_default_config();
+  pwm_config_set_wrap(&pc, 255);
+  pwm_config_set_clkdiv(&pc, 1.0f);
+  pwm_init(slice, &pc, true);
+  pwm_set_gpio_level((uint)pin, 128);
+
+  // Sample clock from a DMA pacing timer: sys_clk * 1 / (sys_clk / rate)
+  int timer = dma_claim_unused_timer(true);
+  dma_timer_set_fraction((uint)timer, 1, (uint16_t)(clock_get_hz(clk_sys) / SYNTH_SAMPLE_RATE));
+
+  dmaChan[0] = dma_claim_unused_channel(true);
+  dmaChan[1] = dma_claim_unused_channel(true);
+  for (int b = 0; b < 2; b++) {
+    for (int i = 0; i < SYNTH_BLOCK; i++) dmaBlock[b][i] = 128;
+    dma_channel_config c = dma_channel_get_default_config((uint)dmaChan[b]);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_16);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, dma_get_timer_dreq((uint)timer));
+    channel_config_set_chain_to(&c, (uint)dmaChan[b ^ 1]);
+    dma_channel_configure((uint)dmaChan[b], &c, &pwm_hw->slice[slice].cc, dmaBlock[b], SYNTH_BLOCK, false);
+    dma_channel_set_irq1_enabled((uint)dmaChan[b], true);
+  }
+  irq_set_exclusive_handler(DMA_IRQ_1, dmaIrq);
+  irq_set_enabled(DMA_IRQ_1, true);
+  dma_channel_start((uint)dmaChan[0]);
+}
+#endif
+
 BuzzSynth::BuzzSynth(int buzzerPin) : _pin(buzzerPin) {
   memset(&snd, 0, sizeof(snd));
   snd.mode = SND_IDLE;
+  memset(voices, 0, sizeof(voices));
+  noiseLfsr = 0xACE1u;
+  seqSteps = nullptr;
+  seqCount = 0;
+  seqStep = 0;
+  seqSamplesLeft = 0;
+  seqDone = false;
+  queued = 0;
+  memset(&qStats, 0, sizeof(qStats));
+#if !defined(ARDUINO_ARCH_RP2040)
+  hostClockMs = 0;
+  hostSampleFrac = 0;
+  hostClockRunning = false;
+  hostSink = nullptr;
+#endif
 }
 
 void BuzzSynth::begin() {
+  if (!tablesBuilt) buildTables();
+#if defined(ARDUINO_ARCH_RP2040)
+  activeSynth = this;
+  startOutput(_pin);
+#else
+  // Host: nothing drives the pin; renderSamples() produces the stream
   pinMode(_pin, OUTPUT);
   digitalWrite(_pin, LOW);
+#endif
 }
 
-float BuzzSynth::clampf(float v, float lo, float hi) {
-  if (v < lo) return lo;
-  if (v > hi) return hi;
-  return v;
+// -------------------- VOICES --------------------
+// Unlocked: for the render path, or with interrupts already off
+void BuzzSynth::gateVoice(uint8_t v, uint32_t freq, uint8_t wave, uint8_t volume,
+                          uint32_t durationMs, uint16_t attackMs, uint16_t releaseMs) {
+  uint32_t atk = (attackMs ? attackMs : 1) * SAMPLES_PER_MS;
+  uint32_t rel = (releaseMs ? releaseMs : 1) * SAMPLES_PER_MS;
+  SynthVoice &vc = voices[v];
+  vc.phaseInc = freq * PHASE_PER_HZ;
+  vc.gateSamples = durationMs * SAMPLES_PER_MS;
+  vc.attackStep = (uint16_t)(65535u / atk + 1u);
+  vc.releaseStep = (uint16_t)(65535u / rel + 1u);
+  vc.volume = volume;
+  vc.wave = wave;
+  vc.gate = true;
+}
+
+void BuzzSynth::noteOn(uint8_t v, uint32_t freq, uint8_t wave, uint8_t volume,
+                       uint32_t durationMs, uint16_t attackMs, uint16_t releaseMs) {
+  noInterrupts();
+  gateVoice(v, freq, wave, volume, durationMs, attackMs, releaseMs);
+  interrupts();
+}
+
+void BuzzSynth::noteOff(uint8_t v) {
+  noInterrupts();
+  voices[v].gate = false;
+  voices[v].gateSamples = 0;
+  interrupts();
+}
+
+// Retune a playing voice without restarting its phase or envelope
+void BuzzSynth::setVoice(uint8_t v, uint32_t freq, uint8_t volume) {
+  uint32_t inc = freq * PHASE_PER_HZ;
+  noInterrupts();
+  voices[v].phaseInc = inc;
+  voices[v].volume = volume;
+  interrupts();
+}
+
+// -------------------- RENDER --------------------
+int32_t BuzzSynth::mixSample() {
+  int32_t mix = 0;
+  for (int v = 0; v < SYNTH_VOICES; v++) {
+    SynthVoice &vc = voices[v];
+    if (vc.gate) {
+      if (vc.gateSamples && --vc.gateSamples == 0) vc.gate = false;
+      uint32_t e = (uint32_t)vc.env + vc.attackStep;
+      vc.env = (uint16_t)(e > 65535u ? 65535u : e);
+    } else if (vc.env) {
+      vc.env = (uint16_t)(vc.env > vc.releaseStep ? vc.env - vc.releaseStep : 0);
+    }
+    if (vc.env == 0) continue;
+
+    uint32_t prev = vc.phase;
+    vc.phase += vc.phaseInc;
+    uint8_t idx = (uint8_t)(vc.phase >> 24);
+    int32_t s;
+    switch (vc.wave) {
+      case WAVE_SQUARE:   s = (idx & 0x80) ? -127 : 127; break;
+      case WAVE_TRIANGLE: s = (idx & 0x80) ? 383 - 2 * (int32_t)idx : 2 * (int32_t)idx - 128; break;
+      case WAVE_SINE:     s = sineTable[idx]; break;
+      case WAVE_BUZZ:     s = buzzTable[idx]; break;
+      default:
+        // New random level once per cycle
+        if (vc.phase < prev) {
+          noiseLfsr ^= noiseLfsr << 13;
+          noiseLfsr ^= noiseLfsr >> 17;
+          noiseLfsr ^= noiseLfsr << 5;
+          vc.noiseHeld = (int8_t)(noiseLfsr >> 24);
+        }
+        s = vc.noiseHeld;
+        break;
+    }
+    mix += (((s * vc.volume) >> 8) * (int32_t)(vc.env >> 8)) >> 8;
+  }
+  return mix;
+}
+
+float BuzzSynth::voiceHz(uint8_t v) const {
+  return (float)voices[v].phaseInc / (float)PHASE_PER_HZ;
+}
+
+uint8_t BuzzSynth::voiceLevel(uint8_t v) const {
+  return (uint8_t)(((uint32_t)voices[v].volume * (voices[v].env >> 8)) >> 8);
+}
+
+void BuzzSynth::renderSamples(uint8_t *out, uint32_t n) {
+  for (uint32_t i = 0; i < n; i++) {
+    if (seqSteps) {
+      if (seqSamplesLeft == 0) advanceSequencer();
+      else seqSamplesLeft--;
+    }
+    int32_t s = mixSample();
+    if (s > 127) s = 127;
+    if (s < -128) s = -128;
+    out[i] = (uint8_t)(s + 128);
+  }
 }
 
 int BuzzSynth::clampi(int v, int lo, int hi) {
@@ -34,157 +236,268 @@ int BuzzSynth::clampi(int v, int lo, int hi) {
   return v;
 }
 
+// -------------------- EFFECT TABLES --------------------
+// freq, duration, gap, tail (ms). Adding an effect is a new table and an
+// SndMode entry; the sequencer needs no changes.
+static constexpr SoundStep SEQ_CLICK[] = {
+  { 1800, 18, 4, 110 },
+};
+
+static constexpr SoundStep SEQ_RADAR[] = {
+  { 1500, 14, 4, 0 },
+  { 980, 50, 10, 0 },
+  { 1220, 55, 15, 140 },
+};
+
+static constexpr SoundStep SEQ_POLLEN_CHIRP[] = {
+  { 940, 55, 10, 0 },
+  { 1160, 55, 10, 0 },
+  { 860, 80, 15, 130 },
+};
+
+static constexpr SoundStep SEQ_POWERUP[] = {
+  { 780, 70, 8, 0 },
+  { 1080, 70, 8, 0 },
+  { 1420, 90, 15, 160 },
+};
+
+// Priority, longest useful wait, coalescing. A click is feedback for a
+// press and useless late; a pollen chirp marks a score and each one plays.
+#define SEQ(steps) steps, (uint8_t)(sizeof(steps) / sizeof(steps[0]))
+static constexpr SoundSeq SOUND_SEQS[] = {
+  { nullptr, 0, 0, 0, SND_QUEUE_EACH },              // SND_IDLE
+  { SEQ(SEQ_CLICK), 1, 40, SND_MERGE },
+  { SEQ(SEQ_RADAR), 2, 120, SND_MERGE },
+  { SEQ(SEQ_POLLEN_CHIRP), 3, 300, SND_QUEUE_EACH },
+  { SEQ(SEQ_POWERUP), 4, 300, SND_MERGE },
+};
+#undef SEQ
+static_assert(sizeof(SOUND_SEQS) / sizeof(SOUND_SEQS[0]) == SND_MODE_COUNT, "one sequence per SndMode");
+
+// -------------------- SEQUENCER --------------------
 void BuzzSynth::startSound(SndMode mode, uint32_t nowMs) {
-  snd.mode = mode;
-  snd.step = 0;
-  snd.nextMs = nowMs;
+  (void)nowMs;    // Timing runs on the sample clock from here
+  const SoundSeq &seq = SOUND_SEQS[mode < SND_MODE_COUNT ? mode : SND_IDLE];
+  snd.mode = seq.count ? mode : SND_IDLE;
   snd.eventTailUntilMs = 0;
+  noInterrupts();
+  seqSteps = seq.steps;
+  seqCount = seq.count;
+  seqStep = 0;
+  seqSamplesLeft = 0;       // First note on the next sample
+  seqDone = false;
+  interrupts();
+}
+
+// -------------------- EVENT QUEUE --------------------
+bool BuzzSynth::postSound(SndMode mode, uint32_t nowMs) {
+  if (mode >= SND_MODE_COUNT || SOUND_SEQS[mode].count == 0) return false;
+  const SoundSeq &seq = SOUND_SEQS[mode];
+  qStats.posted++;
+
+  if (seq.coalesce == SND_MERGE) {
+    bool same = (snd.mode == mode);
+    for (int i = 0; i < queued && !same; i++) same = (queue[i].mode == mode);
+    if (same) {
+      qStats.merged++;
+      return true;
+    }
+  }
+
+  if (queued == SOUND_QUEUE_N) {
+    // Full: evict the newest of the lowest priority, if it ranks below
+    int victim = 0;
+    for (int i = 1; i < queued; i++) {
+      if (SOUND_SEQS[queue[i].mode].priority <= SOUND_SEQS[queue[victim].mode].priority) victim = i;
+    }
+    qStats.dropped++;
+    if (SOUND_SEQS[queue[victim].mode].priority >= seq.priority) return false;
+    dequeue(victim);
+  }
+  queue[queued].mode = (uint8_t)mode;
+  queue[queued].postedMs = nowMs;
+  queued++;
+
+  dispatchQueue(nowMs);
+  return true;
+}
+
+// Order-preserving, so equal priorities stay first come first served
+void BuzzSynth::dequeue(int i) {
+  for (int k = i + 1; k < queued; k++) queue[k - 1] = queue[k];
+  queued--;
+}
+
+void BuzzSynth::dispatchQueue(uint32_t nowMs) {
+  int best = -1;
+  for (int i = 0; i < queued; ) {
+    const SoundSeq &seq = SOUND_SEQS[queue[i].mode];
+    if (nowMs - queue[i].postedMs > seq.maxWaitMs) {
+      qStats.expired++;
+      dequeue(i);
+      continue;
+    }
+    if (best < 0 || seq.priority > SOUND_SEQS[queue[best].mode].priority) best = i;
+    i++;
+  }
+  if (best < 0) return;
+
+  SndMode mode = (SndMode)queue[best].mode;
+  if (snd.mode != SND_IDLE) {
+    if (SOUND_SEQS[mode].priority <= SOUND_SEQS[snd.mode].priority) return;
+    qStats.preempted++;
+  }
+
+  uint32_t waitMs = nowMs - queue[best].postedMs;
+  qStats.started++;
+  qStats.totalWaitMs += waitMs;
+  if (waitMs > qStats.worstWaitMs[mode]) qStats.worstWaitMs[mode] = waitMs;
+  dequeue(best);
+  startSound(mode, nowMs);
+}
+
+void BuzzSynth::resetQueueStats() {
+  memset(&qStats, 0, sizeof(qStats));
+}
+
+// Render context: fire the next step, or finish once the last gap ran out
+void BuzzSynth::advanceSequencer() {
+  if (seqStep < seqCount) {
+    const SoundStep &st = seqSteps[seqStep++];
+    gateVoice(VOICE_EVENT, st.freq, WAVE_SQUARE, EVENT_VOLUME, st.durMs, 2, 6);
+    seqSamplesLeft = (uint32_t)(st.durMs + st.gapMs) * SAMPLES_PER_MS;
+  } else {
+    voices[VOICE_EVENT].gate = false;
+    seqSteps = nullptr;
+    seqDone = true;
+  }
 }
 
 void BuzzSynth::updateSound(uint32_t nowMs) {
-  if (snd.mode == SND_IDLE) return;
-  if ((int32_t)(nowMs - snd.nextMs) < 0) return;
-
-  switch (snd.mode) {
-    case SND_CLICK:
-      if (snd.step == 0) {
-        snd.lastEventFreq = 1800.0f;
-        tone(_pin, (uint16_t)snd.lastEventFreq, 18);
-        snd.nextMs = nowMs + 22;
-        snd.step++;
-      } else {
-        noTone(_pin);
-        snd.eventTailFreq = snd.lastEventFreq;
-        snd.eventTailStartMs = nowMs;
-        snd.eventTailUntilMs = nowMs + 110;
-        snd.mode = SND_IDLE;
-      }
-      break;
-
-    case SND_RADAR:
-      if (snd.step == 0) {
-        snd.lastEventFreq = 1500.0f;
-        tone(_pin, (uint16_t)snd.lastEventFreq, 14);
-        snd.nextMs = nowMs + 18;
-        snd.step++;
-      } else if (snd.step == 1) {
-        snd.lastEventFreq = 980.0f;
-        tone(_pin, (uint16_t)snd.lastEventFreq, 50);
-        snd.nextMs = nowMs + 60;
-        snd.step++;
-      } else if (snd.step == 2) {
-        snd.lastEventFreq = 1220.0f;
-        tone(_pin, (uint16_t)snd.lastEventFreq, 55);
-        snd.nextMs = nowMs + 70;
-        snd.step++;
-      } else {
-        noTone(_pin);
-        snd.eventTailFreq = snd.lastEventFreq;
-        snd.eventTailStartMs = nowMs;
-        snd.eventTailUntilMs = nowMs + 140;
-        snd.mode = SND_IDLE;
-      }
-      break;
-
-    case SND_POLLEN_CHIRP:
-      if (snd.step == 0) {
-        snd.lastEventFreq = 940.0f;
-        tone(_pin, (uint16_t)snd.lastEventFreq, 55);
-        snd.nextMs = nowMs + 65;
-        snd.step++;
-      } else if (snd.step == 1) {
-        snd.lastEventFreq = 1160.0f;
-        tone(_pin, (uint16_t)snd.lastEventFreq, 55);
-        snd.nextMs = nowMs + 65;
-        snd.step++;
-      } else if (snd.step == 2) {
-        snd.lastEventFreq = 860.0f;
-        tone(_pin, (uint16_t)snd.lastEventFreq, 80);
-        snd.nextMs = nowMs + 95;
-        snd.step++;
-      } else {
-        noTone(_pin);
-        snd.eventTailFreq = snd.lastEventFreq;
-        snd.eventTailStartMs = nowMs;
-        snd.eventTailUntilMs = nowMs + 130;
-        snd.mode = SND_IDLE;
-      }
-      break;
-
-    case SND_POWERUP:
-      if (snd.step == 0) {
-        snd.lastEventFreq = 780.0f;
-        tone(_pin, (uint16_t)snd.lastEventFreq, 70);
-        snd.nextMs = nowMs + 78;
-        snd.step++;
-      } else if (snd.step == 1) {
-        snd.lastEventFreq = 1080.0f;
-        tone(_pin, (uint16_t)snd.lastEventFreq, 70);
-        snd.nextMs = nowMs + 78;
-        snd.step++;
-      } else if (snd.step == 2) {
-        snd.lastEventFreq = 1420.0f;
-        tone(_pin, (uint16_t)snd.lastEventFreq, 90);
-        snd.nextMs = nowMs + 105;
-        snd.step++;
-      } else {
-        noTone(_pin);
-        snd.eventTailFreq = snd.lastEventFreq;
-        snd.eventTailStartMs = nowMs;
-        snd.eventTailUntilMs = nowMs + 160;
-        snd.mode = SND_IDLE;
-      }
-      break;
-
-    default:
-      snd.mode = SND_IDLE;
-      noTone(_pin);
-      break;
+#if !defined(ARDUINO_ARCH_RP2040)
+  // Host stand-in: nothing pulls samples, so run the render on the same
+  // timeline the DMA would have and hand the output to the sink, if any.
+  if (!hostClockRunning) {
+    hostClockMs = nowMs;
+    hostClockRunning = true;
+  }
+  uint32_t elapsed = nowMs - hostClockMs;
+  if (elapsed > 100) elapsed = 100;
+  hostClockMs = nowMs;
+  hostSampleFrac += elapsed * SYNTH_SAMPLE_RATE;
+  uint32_t due = hostSampleFrac / 1000u;
+  hostSampleFrac -= due * 1000u;
+  uint8_t scratch[SYNTH_BLOCK];
+  while (due > 0) {
+    uint32_t chunk = due < (uint32_t)SYNTH_BLOCK ? due : (uint32_t)SYNTH_BLOCK;
+    renderSamples(scratch, chunk);
+    if (hostSink) hostSink(scratch, chunk);
+    due -= chunk;
   }
+#endif
+  if (snd.mode != SND_IDLE && seqDone) {
+    const SoundStep &last = SOUND_SEQS[snd.mode].steps[SOUND_SEQS[snd.mode].count - 1];
+    snd.lastEventFreq = fxFromInt(last.freq);
+    setEventTail(nowMs, snd.lastEventFreq, last.tailMs);
+    snd.mode = SND_IDLE;
+    seqDone = false;
+  }
+  if (queued) dispatchQueue(nowMs);
 }
 
 bool BuzzSynth::soundBusy() const {
   return snd.mode != SND_IDLE;
 }
 
-void BuzzSynth::updateAmbient(uint32_t nowMs, float dt, float wingSpeed,
-                               float vx, float vy, float speed) {
-  if (soundBusy()) return;
-
-  // Calculate heading and turn rate
-  float heading = snd.heading;
-  if (speed > 0.02f) heading = atan2f(vy, vx);
-  float dHeading = heading - snd.heading;
-  while (dHeading > 3.1415926f) dHeading -= 6.2831853f;
-  while (dHeading < -3.1415926f) dHeading += 6.2831853f;
-  float turnRate = (dt > 0.0001f) ? (dHeading / dt) : 0.0f;
-  snd.heading = heading;
+// -------------------- AMBIENT MODEL --------------------
+// Q16.16 throughout, trig from the FastTrig tables; rates are per second.
+// Time steps stay in microseconds: 1 ms is only 65.5 LSB as a Q16.16
+// second, too coarse for the smoothing factors.
+static const uint32_t AMB_DT_MIN_US = 100;
+static const uint32_t AMB_DT_MAX_US = 1000000;      // Longer is a stall, not a rate
+static const fix16 AMB_MOVING = fxFromFloat(0.02f);
+static const fix16 AMB_RATE_MAX = fxFromInt(16000);   // Rates saturate here
+static const fix16 FX_TWO_PI = fxFromFloat(6.2831853f);
+
+// k * dt as a blend factor in [0, 1]
+static inline fix16 blendFor(int32_t k, uint32_t dtUs) {
+  return fxClamp(fxRatio(k * (int32_t)dtUs, 1000000), 0, FX_ONE);
+}
+
+// x / dt, saturated so a velocity jump cannot overflow Q16.16
+static inline fix16 perSecond(fix16 x, uint32_t dtUs) {
+  int64_t r = (int64_t)x * 1000000 / (int64_t)dtUs;
+  if (r > AMB_RATE_MAX) return AMB_RATE_MAX;
+  if (r < -AMB_RATE_MAX) return -AMB_RATE_MAX;
+  return (fix16)r;
+}
 
-  // Calculate acceleration
-  float dvx = vx - snd.prevVX;
-  float dvy = vy - snd.prevVY;
-  float accelMag = (dt > 0.0001f) ? (sqrtf(dvx * dvx + dvy * dvy) / dt) : 0.0f;
-  float accelAlong = 0.0f;
-  if (speed > 0.02f && dt > 0.0001f) {
-    accelAlong = (dvx * vx + dvy * vy) / (speed * dt);
+// Smooth the rate x / dt with blend k * dt. Expanded, s += (x/dt - s) * k*dt
+// is s + k*x - k*dt*s: no divide, and a one-tick spike adds k*x however
+// short the tick, exactly as the float model did.
+static inline fix16 smoothRate(fix16 s, fix16 x, int32_t k, uint32_t dtUs) {
+  fix16 b = blendFor(k, dtUs);
+  if (b >= FX_ONE) return perSecond(x, dtUs);
+  return s + k * x - fxMul(b, s);
+}
+
+// Progress of nowMs through [startMs, untilMs], clamped to [0, 1]
+static inline fix16 windowT(uint32_t nowMs, uint32_t startMs, uint32_t untilMs) {
+  int32_t span = (int32_t)(untilMs - startMs);
+  if (span <= 0) return FX_ONE;
+  return fxClamp(fxRatio((int32_t)(nowMs - startMs), span), 0, FX_ONE);
+}
+
+void BuzzSynth::updateAmbient(uint32_t nowMs, uint32_t dtUs, fix16 wingSpeed,
+                               fix16 vx, fix16 vy, fix16 speed) {
+  // Events own the speaker; the buzz fades out under them
+  if (soundBusy()) {
+    noteOff(VOICE_AMBIENT);
+    return;
+  }
+  if (dtUs > AMB_DT_MAX_US) dtUs = AMB_DT_MAX_US;
+  bool hasDt = dtUs > AMB_DT_MIN_US;
+  bool moving = speed > AMB_MOVING;
+
+  // Per-tick changes; rates are these over dt, but are only ever smoothed
+  // or compared, so the divide is folded away
+  angle16 heading = moving ? iatan2(vy, vx) : snd.heading;
+  fix16 dHeading = 0, dvMag = 0, dvAlong = 0;
+  if (hasDt) {
+    // Binary angles wrap on their own
+    dHeading = (fix16)(((int64_t)(int16_t)(angle16)(heading - snd.heading) * FX_TWO_PI) >> 16);
+    fix16 dvx = vx - snd.prevVX;
+    fix16 dvy = vy - snd.prevVY;
+    dvMag = fxHypot(dvx, dvy);
+    if (moving) {
+      // (dv . v) / speed, with the dot product kept at Q32.32
+      int64_t dot = (int64_t)dvx * vx + (int64_t)dvy * vy;
+      dvAlong = (fix16)(dot / speed);
+    }
   }
+  snd.heading = heading;
 
   // Smooth values
-  float smoothRate = clampf(6.0f * dt, 0.0f, 1.0f);
-  snd.turnRateSmooth += (turnRate - snd.turnRateSmooth) * smoothRate;
-  snd.accelSmooth += (accelMag - snd.accelSmooth) * clampf(4.0f * dt, 0.0f, 1.0f);
-  snd.radialAccelSmooth += (accelAlong - snd.radialAccelSmooth) * clampf(5.0f * dt, 0.0f, 1.0f);
+  snd.turnRateSmooth = smoothRate(snd.turnRateSmooth, dHeading, 6, dtUs);
+  snd.accelSmooth = smoothRate(snd.accelSmooth, dvMag, 4, dtUs);
+  snd.radialAccelSmooth = smoothRate(snd.radialAccelSmooth, dvAlong, 5, dtUs);
 
-  // Swish on sharp turns
-  if (fabsf(turnRate) > 3.2f && (int32_t)(nowMs - snd.swishUntilMs) > 0) {
+  // Swish on sharp turns (turn rate above 3.2 rad/s)
+  if (hasDt && (int64_t)fxAbs(dHeading) * 1000000 > (int64_t)fxFromFloat(3.2f) * dtUs
+      && (int32_t)(nowMs - snd.swishUntilMs) > 0) {
     snd.swishStartMs = nowMs;
     snd.swishUntilMs = nowMs + 120;
-    snd.swishSign = (turnRate >= 0.0f) ? 1.0f : -1.0f;
+    snd.swishSign = (dHeading >= 0) ? 1 : -1;
+    noteOn(VOICE_NOISE, 2600, WAVE_NOISE, SWISH_VOLUME, 60, 15, 60);
   }
 
-  // Acceleration pulse
-  float accelN = clampf(accelMag / 420.0f, 0.0f, 1.0f);
-  if (accelN > 0.35f && (int32_t)(nowMs - snd.accelPulseUntilMs) > 0) {
+  // Acceleration pulse, strength = accel / 420 clamped to 1
+  fix16 accelN = 0;
+  if (hasDt) {
+    fix16 full = fxRatio(420 * (int32_t)dtUs, 1000000);
+    accelN = (dvMag >= full) ? FX_ONE : fxDiv(dvMag, full);
+  }
+  if (accelN > fxFromFloat(0.35f) && (int32_t)(nowMs - snd.accelPulseUntilMs) > 0) {
     snd.accelPulseStartMs = nowMs;
     snd.accelPulseUntilMs = nowMs + 140;
     snd.accelPulseStrength = accelN;
@@ -195,77 +508,90 @@ void BuzzSynth::updateAmbient(uint32_t nowMs, float dt, float wingSpeed,
 
   // Calculate ambient envelope
   bool tailActive = (int32_t)(nowMs - snd.eventTailUntilMs) < 0;
-  float envTarget = (wingSpeed > 0.05f || tailActive) ? 1.0f : 0.0f;
-  float envRate = (envTarget > snd.ambientEnv) ? 8.0f : 4.0f;
-  snd.ambientEnv += (envTarget - snd.ambientEnv) * clampf(envRate * dt, 0.0f, 1.0f);
+  fix16 envTarget = (wingSpeed > fxFromFloat(0.05f) || tailActive) ? FX_ONE : 0;
+  int32_t envRate = (envTarget > snd.ambientEnv) ? 8 : 4;
+  snd.ambientEnv += fxMul(envTarget - snd.ambientEnv, blendFor(envRate, dtUs));
 
   // Calculate frequency
-  float base = 220.0f + wingSpeed * 520.0f;
+  fix16 base = fxFromInt(220) + wingSpeed * 520;
   uint32_t jitterSeed = hash32((uint32_t)(nowMs >> 2) + 0x5f3759dfu);
-  float jitter = ((int)(jitterSeed & 0x7u) - 3) * 2.2f;
+  fix16 jitter = ((int32_t)(jitterSeed & 0x7u) - 3) * fxFromFloat(2.2f);
 
-  float turnSkew = clampf(snd.turnRateSmooth * 0.75f, -22.0f, 22.0f);
-  float doppler = clampf(snd.radialAccelSmooth * 0.06f, -22.0f, 22.0f);
+  fix16 turnSkew = fxClamp(fxMul(snd.turnRateSmooth, fxFromFloat(0.75f)), fxFromInt(-22), fxFromInt(22));
+  fix16 doppler = fxClamp(fxMul(snd.radialAccelSmooth, fxFromFloat(0.06f)), fxFromInt(-22), fxFromInt(22));
 
-  float vibRate = 7.5f + clampf(fabsf(snd.turnRateSmooth) * 0.14f, 0.0f, 6.5f);
-  float vibDepth = 3.5f + wingSpeed * 8.0f
-    + clampf(snd.accelSmooth * 0.045f, 0.0f, 10.0f)
-    + clampf(fabsf(snd.turnRateSmooth) * 0.22f, 0.0f, 7.0f);
-  snd.vibratoPhase += 6.2831853f * vibRate * dt;
-  float vib = sinf(snd.vibratoPhase) * vibDepth;
+  fix16 absTurn = fxAbs(snd.turnRateSmooth);
+  fix16 vibRate = fxFromFloat(7.5f) + fxClamp(fxMul(absTurn, fxFromFloat(0.14f)), 0, fxFromFloat(6.5f));
+  fix16 vibDepth = fxFromFloat(3.5f) + wingSpeed * 8
+    + fxClamp(fxMul(snd.accelSmooth, fxFromFloat(0.045f)), 0, fxFromInt(10))
+    + fxClamp(fxMul(absTurn, fxFromFloat(0.22f)), 0, fxFromInt(7));
+  // Hz * s is turns, and a Q16.16 turn count is an angle16 step
+  snd.vibratoPhase += (angle16)(((int64_t)vibRate * dtUs) / 1000000);
+  fix16 vib = fxMul(fxSin(snd.vibratoPhase), vibDepth);
 
-  float swish = 0.0f;
+  fix16 swish = 0;
   if ((int32_t)(nowMs - snd.swishUntilMs) < 0) {
-    float t = (float)(nowMs - snd.swishStartMs) / (float)(snd.swishUntilMs - snd.swishStartMs);
-    t = clampf(t, 0.0f, 1.0f);
-    float env = 1.0f - fabsf(1.0f - 2.0f * t);
-    swish = snd.swishSign * 18.0f * env;
+    fix16 t = windowT(nowMs, snd.swishStartMs, snd.swishUntilMs);
+    fix16 env = FX_ONE - fxAbs(FX_ONE - 2 * t);
+    swish = snd.swishSign * 18 * env;
   }
 
-  float accelPulse = 0.0f;
+  fix16 accelPulse = 0;
   if ((int32_t)(nowMs - snd.accelPulseUntilMs) < 0) {
-    float t = (float)(nowMs - snd.accelPulseStartMs) / (float)(snd.accelPulseUntilMs - snd.accelPulseStartMs);
-    t = clampf(t, 0.0f, 1.0f);
-    float env = 1.0f - t;
-    accelPulse = snd.accelPulseStrength * 20.0f * env;
+    fix16 t = windowT(nowMs, snd.accelPulseStartMs, snd.accelPulseUntilMs);
+    accelPulse = fxMul(snd.accelPulseStrength * 20, FX_ONE - t);
   }
 
-  float target = base + jitter + turnSkew + doppler + vib + swish + accelPulse;
+  fix16 target = base + jitter + turnSkew + doppler + vib + swish + accelPulse;
 
   // Blend with event tail
   if (tailActive && snd.eventTailUntilMs > snd.eventTailStartMs) {
-    float t = (float)(nowMs - snd.eventTailStartMs) / (float)(snd.eventTailUntilMs - snd.eventTailStartMs);
-    t = clampf(t, 0.0f, 1.0f);
-    float blend = t * t;
-    target = snd.eventTailFreq * (1.0f - blend) + target * blend;
+    fix16 t = windowT(nowMs, snd.eventTailStartMs, snd.eventTailUntilMs);
+    target = fxLerp(snd.eventTailFreq, target, fxMul(t, t));
   }
 
-  snd.ambientFreqSmooth += (target - snd.ambientFreqSmooth) * clampf(10.0f * dt, 0.0f, 1.0f);
+  snd.ambientFreqSmooth += fxMul(target - snd.ambientFreqSmooth, blendFor(10, dtUs));
 
-  // Output
-  if (snd.ambientEnv > 0.05f) {
-    int freq = clampi((int)(snd.ambientFreqSmooth), 180, 980);
-    tone(_pin, (uint16_t)freq);
+  // Output: retune the held buzz voice, level follows the envelope
+  if (snd.ambientEnv > fxFromFloat(0.05f)) {
+    uint32_t freq = (uint32_t)clampi(fxTrunc(snd.ambientFreqSmooth), 180, 980);
+    uint8_t vol = (uint8_t)fxTrunc(snd.ambientEnv * AMBIENT_VOLUME);
+    if (!voices[VOICE_AMBIENT].gate) noteOn(VOICE_AMBIENT, freq, WAVE_BUZZ, vol, 0, 20, 40);
+    else setVoice(VOICE_AMBIENT, freq, vol);
   } else {
-    noTone(_pin);
+    noteOff(VOICE_AMBIENT);
   }
 }
 
 void BuzzSynth::stopAll() {
-  noTone(_pin);
+  noInterrupts();
+  seqSteps = nullptr;
+  seqDone = false;
+  interrupts();
+  for (uint8_t v = 0; v < SYNTH_VOICES; v++) noteOff(v);
+  queued = 0;
   snd.mode = SND_IDLE;
   snd.eventTailUntilMs = 0;
-  snd.ambientEnv = 0.0f;
-  snd.ambientFreqSmooth = 0.0f;
-  snd.lastUnloadFreq = 0.0f;
+  snd.ambientEnv = 0;
+  snd.ambientFreqSmooth = 0;
+  snd.lastUnloadFreq = 0;
 }
 
 void BuzzSynth::playUnloadTone(uint16_t freq, uint16_t durationMs) {
-  snd.lastUnloadFreq = (float)freq;
-  tone(_pin, freq, durationMs);
+  if (snd.mode != SND_IDLE) {
+    qStats.preempted++;
+    snd.mode = SND_IDLE;
+  }
+  noInterrupts();
+  seqSteps = nullptr;
+  seqDone = false;
+  voices[VOICE_AMBIENT].gate = false;
+  interrupts();
+  snd.lastUnloadFreq = fxFromInt(freq);
+  noteOn(VOICE_EVENT, freq, WAVE_TRIANGLE, EVENT_VOLUME, durationMs, 3, 10);
 }
 
-void BuzzSynth::setEventTail(uint32_t nowMs, float freq, uint32_t durationMs) {
+void BuzzSynth::setEventTail(uint32_t nowMs, fix16 freq, uint32_t durationMs) {
   snd.eventTailFreq = freq;
   snd.eventTailStartMs = nowMs;
   snd.eventTailUntilMs = nowMs + durationMs;
@@ -3,6 +3,46 @@
 #pragma once
 
 #include <Arduino.h>
+#include "FixedMath.h"
+#include "FastTrig.h"
+
+// Output stage: 8-bit samples at SYNTH_SAMPLE_RATE as the duty cycle of a
+// fast PWM carrier on the buzzer pin. On RP2040 two chained DMA channels
+// paced by a DMA timer play alternate blocks and the completion interrupt
+// renders the block that just finished, so playback never waits on the
+// main loop.
+static const uint32_t SYNTH_SAMPLE_RATE = 22050;
+static const int SYNTH_BLOCK = 128;            // Samples per DMA block (~5.8 ms)
+
+// Oscillator shapes
+enum SynthWave : uint8_t {
+  WAVE_SQUARE = 0,
+  WAVE_TRIANGLE,
+  WAVE_SINE,
+  WAVE_BUZZ,        // Bright saw (first 8 harmonics), the wing buzz
+  WAVE_NOISE        // Sample-and-hold LFSR noise, rate set by the frequency
+};
+
+// Fixed voice roles
+enum SynthVoiceId : uint8_t {
+  VOICE_AMBIENT = 0,
+  VOICE_EVENT,
+  VOICE_NOISE,
+  SYNTH_VOICES
+};
+
+struct SynthVoice {
+  uint32_t phase;         // Oscillator phase, one cycle = 2^32
+  uint32_t phaseInc;      // Per sample
+  uint32_t gateSamples;   // Samples until automatic note-off (0 = held)
+  uint16_t env;           // Envelope level, 0..65535
+  uint16_t attackStep;    // Envelope rise per sample while gated
+  uint16_t releaseStep;   // Envelope fall per sample after note-off
+  uint8_t volume;         // Peak level, 0..255
+  uint8_t wave;
+  bool gate;
+  int8_t noiseHeld;       // Current noise value (WAVE_NOISE)
+};
 
 // Sound modes
 enum SndMode : uint8_t {
@@ -11,33 +51,85 @@ enum SndMode : uint8_t {
   SND_RADAR,
   SND_POLLEN_CHIRP,
   SND_POWERUP,
+  SND_MODE_COUNT
+};
+
+// One note of an effect. tailMs is the ambient glide back from the
+// effect's pitch and is read from the final step only.
+struct SoundStep {
+  uint16_t freq;      // Hz
+  uint16_t durMs;     // Note length
+  uint16_t gapMs;     // Silence before the next step
+  uint16_t tailMs;
+};
+
+// How a new post treats the same effect already pending or playing
+enum SndCoalesce : uint8_t {
+  SND_QUEUE_EACH = 0,     // Every post plays
+  SND_MERGE               // Folds into an identical pending or playing event
+};
+
+struct SoundSeq {
+  const SoundStep *steps;
+  uint8_t count;
+  uint8_t priority;       // Higher preempts lower
+  uint16_t maxWaitMs;     // Pending longer than this: expired, never played
+  uint8_t coalesce;       // SndCoalesce
+};
+
+// Posted effects wait here until the speaker is free or they outrank the
+// one playing. A post is never waiting longer than its maxWaitMs.
+static const int SOUND_QUEUE_N = 8;
+
+// Rendered blocks in flight ahead of the DMA read position: the extra
+// delay from an effect starting to it being heard.
+static const uint32_t SYNTH_PIPELINE_MS = (2u * SYNTH_BLOCK * 1000u + SYNTH_SAMPLE_RATE - 1) / SYNTH_SAMPLE_RATE;
+
+struct PendingSound {
+  uint8_t mode;
+  uint32_t postedMs;
 };
 
-// Sound state structure
+#if !defined(ARDUINO_ARCH_RP2040)
+// Host builds: receives the stream updateSound() renders
+typedef void (*SynthSampleSink)(const uint8_t *samples, uint32_t n);
+#endif
+
+struct SoundQueueStats {
+  uint32_t posted;
+  uint32_t started;
+  uint32_t merged;        // Folded into an identical event
+  uint32_t expired;       // Waited past maxWaitMs
+  uint32_t preempted;     // Cut short by a higher priority event or the unload chirps
+  uint32_t dropped;       // Queue full of equal or higher priority
+  uint32_t totalWaitMs;   // Post -> start, for the mean
+  uint32_t worstWaitMs[SND_MODE_COUNT];
+};
+
+// Sound state structure. The ambient model is Q16.16: frequencies in Hz,
+// rates per second, envelopes and strengths in [0, 1].
 struct SoundState {
   SndMode mode;
-  uint8_t step;
-  uint32_t nextMs;
-  float lastEventFreq;
+  fix16 lastEventFreq;
   uint32_t eventTailUntilMs;
   uint32_t eventTailStartMs;
-  float eventTailFreq;
-  float ambientFreqSmooth;
-  float ambientEnv;
-  float prevVX;
-  float prevVY;
-  float heading;
-  float turnRateSmooth;
-  float accelSmooth;
-  float radialAccelSmooth;
-  float vibratoPhase;
+  fix16 eventTailFreq;
+  fix16 ambientFreqSmooth;
+  fix16 ambientEnv;
+  fix16 prevVX;
+  fix16 prevVY;
+  angle16 heading;
+  fix16 turnRateSmooth;       // rad/s
+  fix16 accelSmooth;
+  fix16 radialAccelSmooth;
+  angle16 vibratoPhase;
   uint32_t swishUntilMs;
   uint32_t swishStartMs;
-  float swishSign;
+  int8_t swishSign;
   uint32_t accelPulseUntilMs;
   uint32_t accelPulseStartMs;
-  float accelPulseStrength;
-  float lastUnloadFreq;
+  fix16 accelPulseStrength;
+  fix16 lastUnloadFreq;
 };
 
 class BuzzSynth {
@@ -47,37 +139,90 @@ public:
   // Initialize the synthesizer
   void begin();
 
-  // Start a sound effect
+  // Queue a sound effect by its priority; plays at once if it can.
+  // Returns false if it was dropped.
+  bool postSound(SndMode mode, uint32_t nowMs);
+
+  // Start a sound effect now, bypassing the queue
   void startSound(SndMode mode, uint32_t nowMs);
 
-  // Update sound state machine (call every frame)
+  // Collect finished effects and start queued ones (call every frame). The
+  // sequencer itself runs on the sample clock; on host builds this also
+  // advances that clock.
   void updateSound(uint32_t nowMs);
 
+  const SoundQueueStats &queueStats() const { return qStats; }
+  void resetQueueStats();
+
   // Check if a sound effect is playing
   bool soundBusy() const;
 
-  // Update ambient wing buzz based on movement
-  void updateAmbient(uint32_t nowMs, float dt, float wingSpeed,
-                     float vx, float vy, float speed);
+  // Update ambient wing buzz based on movement (wingSpeed in [0, 1],
+  // velocity in world units/s)
+  void updateAmbient(uint32_t nowMs, uint32_t dtUs, fix16 wingSpeed,
+                     fix16 vx, fix16 vy, fix16 speed);
 
   // Stop all sounds
   void stopAll();
 
-  // Play unload chirp tone
+  // Play unload chirp tone; cuts the running effect, keeps the queue
   void playUnloadTone(uint16_t freq, uint16_t durationMs);
 
   // Set event tail for smooth transitions
-  void setEventTail(uint32_t nowMs, float freq, uint32_t durationMs);
+  void setEventTail(uint32_t nowMs, fix16 freq, uint32_t durationMs);
 
   // Get sound state for direct manipulation if needed
   SoundState& getState() { return snd; }
   const SoundState& getState() const { return snd; }
 
+  // Mix the next n output samples (128 = silence). The DMA interrupt does
+  // this on hardware; host tools can call it directly.
+  void renderSamples(uint8_t *out, uint32_t n);
+
+  // Pitch and current level (0..255) of a voice, for timelines and tools
+  float voiceHz(uint8_t v) const;
+  uint8_t voiceLevel(uint8_t v) const;
+
+#if !defined(ARDUINO_ARCH_RP2040)
+  void setSampleSink(SynthSampleSink sink) { hostSink = sink; }
+#endif
+
 private:
   int _pin;
   SoundState snd;
+  SynthVoice voices[SYNTH_VOICES];
+  uint32_t noiseLfsr;
+
+  // Effect sequencer, advanced from the render path
+  const SoundStep *seqSteps;
+  uint8_t seqCount;
+  uint8_t seqStep;
+  uint32_t seqSamplesLeft;    // Until the next step fires
+  volatile bool seqDone;      // Finished; updateSound() starts the tail
+
+  PendingSound queue[SOUND_QUEUE_N];
+  uint8_t queued;
+  SoundQueueStats qStats;
+#if !defined(ARDUINO_ARCH_RP2040)
+  uint32_t hostClockMs;
+  uint32_t hostSampleFrac;    // Sample-rate remainder carried between calls
+  bool hostClockRunning;
+  SynthSampleSink hostSink;
+#endif
+
+  // Voice control from the main loop; each update is atomic with respect
+  // to the render interrupt.
+  void noteOn(uint8_t v, uint32_t freq, uint8_t wave, uint8_t volume,
+              uint32_t durationMs, uint16_t attackMs, uint16_t releaseMs);
+  void noteOff(uint8_t v);
+  void setVoice(uint8_t v, uint32_t freq, uint8_t volume);
+  void gateVoice(uint8_t v, uint32_t freq, uint8_t wave, uint8_t volume,
+                 uint32_t durationMs, uint16_t attackMs, uint16_t releaseMs);
+  void advanceSequencer();
+  void dispatchQueue(uint32_t nowMs);
+  void dequeue(int i);
+  int32_t mixSample();
 
   // Internal clamp helper
-  static float clampf(float v, float lo, float hi);
   static int clampi(int v, int lo, int hi);
 };
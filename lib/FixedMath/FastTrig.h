@@ -0,0 +1,177 @@
+// FixedMath - Table-Driven Trigonometry and Integer Square Root
+// Replaces sinf/cosf/atan2f/sqrtf on FPU-less targets (RP2040 / Cortex-M0+)
+#pragma once
+
+#include <stdint.h>
+#include "FixedMath.h"
+
+// -------------------- BINARY ANGLE --------------------
+// 65536 units per full turn; wraps naturally on overflow, so phase
+// accumulators never need a modulo or a while-loop wrap.
+typedef uint16_t angle16;
+
+static const angle16 ANGLE_QUARTER = 0x4000;
+static const angle16 ANGLE_HALF = 0x8000;
+static const float ANGLE_PER_RADIAN = 10430.378f;   // 65536 / (2*pi)
+static const float RADIANS_PER_ANGLE = 9.5873799e-5f;
+
+// Valid for |rad| < ~2e5 (int32 range of the scaled value).
+static inline angle16 angleFromRadians(float rad) {
+  return (angle16)(int32_t)(rad * ANGLE_PER_RADIAN);
+}
+
+static inline angle16 angleFromDegrees(int32_t deg) {
+  return (angle16)((deg * 65536) / 360);
+}
+
+// Signed result in [-pi, pi).
+static inline float angleToRadians(angle16 a) {
+  return (float)(int16_t)a * RADIANS_PER_ANGLE;
+}
+
+// Fraction num/den of a full turn (e.g. elapsed ms within a period).
+static inline angle16 angleFromTurns(uint32_t num, uint32_t den) {
+  return (angle16)((num << 16) / den);
+}
+
+// -------------------- SINE TABLE --------------------
+// 256 segments per turn (+1 guard entry), Q15 amplitude, built at compile
+// time. Linear interpolation between entries keeps the absolute error of
+// isin/icos below 1.2e-4 (~4 LSB in Q15): 7.5e-5 from interpolation plus
+// rounding of the table entries.
+static const int SIN_TABLE_BITS = 8;
+static const int SIN_TABLE_N = 1 << SIN_TABLE_BITS;
+
+struct SinTable {
+  int16_t v[SIN_TABLE_N + 1];
+};
+
+// Taylor series for x in [-pi/2, pi/2]; only ever evaluated by the compiler.
+static constexpr double ctSinReduced(double x) {
+  double x2 = x * x;
+  double term = x;
+  double sum = x;
+  for (int n = 1; n < 12; n++) {
+    term *= -x2 / (double)((2 * n) * (2 * n + 1));
+    sum += term;
+  }
+  return sum;
+}
+
+static constexpr SinTable ctMakeSinTable() {
+  SinTable t{};
+  for (int i = 0; i <= SIN_TABLE_N; i++) {
+    double turn = (double)(i % SIN_TABLE_N) / (double)SIN_TABLE_N;
+    double x = (turn < 0.25) ? turn : (turn < 0.75) ? (0.5 - turn) : (turn - 1.0);
+    double s = ctSinReduced(x * 6.283185307179586) * 32767.0;
+    t.v[i] = (int16_t)(s + ((s >= 0.0) ? 0.5 : -0.5));
+  }
+  return t;
+}
+
+static constexpr SinTable SIN_TABLE = ctMakeSinTable();
+
+// -------------------- SIN / COS --------------------
+// Q15 result in [-32767, 32767].
+static inline int16_t isin(angle16 a) {
+  uint32_t idx = (uint32_t)a >> (16 - SIN_TABLE_BITS);
+  int32_t frac = (int32_t)(a & ((1u << (16 - SIN_TABLE_BITS)) - 1u));
+  int32_t s0 = SIN_TABLE.v[idx];
+  int32_t s1 = SIN_TABLE.v[idx + 1];
+  return (int16_t)(s0 + (((s1 - s0) * frac) >> (16 - SIN_TABLE_BITS)));
+}
+
+static inline int16_t icos(angle16 a) {
+  return isin((angle16)(a + ANGLE_QUARTER));
+}
+
+// Q16.16 result in [-1, 1]. Q15 full scale is 32767, so doubling alone
+// would peak at 65534; the rounded x/16384 term restores the 65536/32767
+// scale (to within half an LSB).
+static inline fix16 fxFromQ15(int32_t s) { return s * 2 + ((s + 8192) >> 14); }
+static inline fix16 fxSin(angle16 a) { return fxFromQ15(isin(a)); }
+static inline fix16 fxCos(angle16 a) { return fxFromQ15(icos(a)); }
+
+// Float result, for call sites that stay in float but drop the libm call.
+static inline float fastSinf(angle16 a) { return (float)isin(a) * (1.0f / 32767.0f); }
+static inline float fastCosf(angle16 a) { return (float)icos(a) * (1.0f / 32767.0f); }
+
+// amplitude * sin(a), truncated toward zero like (int)(sinf(x) * amplitude).
+static inline int32_t isinScaled(angle16 a, int32_t amplitude) {
+  return ((int32_t)isin(a) * amplitude) / 32768;
+}
+
+static inline int32_t icosScaled(angle16 a, int32_t amplitude) {
+  return ((int32_t)icos(a) * amplitude) / 32768;
+}
+
+// -------------------- ATAN2 --------------------
+// Octant reduction plus atan(z) ~= (pi/4)z + 0.273z(1-z) on z in [0, 1].
+// Maximum error 0.004 rad (0.23 deg, ~42 angle units). iatan2(0, 0) = 0.
+static inline angle16 iatan2(int32_t y, int32_t x) {
+  if (x == 0 && y == 0) return 0;
+  uint32_t ax = (x < 0) ? (uint32_t)(-(int64_t)x) : (uint32_t)x;
+  uint32_t ay = (y < 0) ? (uint32_t)(-(int64_t)y) : (uint32_t)y;
+
+  // Keep the ratio numerator within 32 bits
+  while ((ax | ay) > 0xFFFFu) {
+    ax >>= 1;
+    ay >>= 1;
+  }
+
+  bool steep = ay > ax;
+  uint32_t lo = steep ? ax : ay;
+  uint32_t hi = steep ? ay : ax;
+  if (hi == 0) hi = 1;
+
+  // z in Q15, result in angle units for the first octant [0, 0x2000]
+  int32_t z = (int32_t)((lo << 15) / hi);
+  int32_t a = (8192 * z + ((2847 * ((z * (32768 - z)) >> 15)))) >> 15;
+
+  if (steep) a = ANGLE_QUARTER - a;
+  if (x < 0) a = ANGLE_HALF - a;
+  if (y < 0) a = -a;
+  return (angle16)a;
+}
+
+// -------------------- SQUARE ROOT --------------------
+// Exact floor(sqrt(v)); 16 iterations of shift/add/compare, no divides.
+static inline uint32_t isqrt32(uint32_t v) {
+  uint32_t res = 0;
+  uint32_t bit = 1u << 30;
+  while (bit > v) bit >>= 2;
+  while (bit != 0) {
+    if (v >= res + bit) {
+      v -= res + bit;
+      res = (res >> 1) + bit;
+    } else {
+      res >>= 1;
+    }
+    bit >>= 2;
+  }
+  return res;
+}
+
+// Exact floor(sqrt(v)) for 64-bit inputs.
+static inline uint32_t isqrt64(uint64_t v) {
+  if (v <= 0xFFFFFFFFull) return isqrt32((uint32_t)v);
+  uint64_t res = 0;
+  uint64_t bit = 1ull << 62;
+  while (bit > v) bit >>= 2;
+  while (bit != 0) {
+    if (v >= res + bit) {
+      v -= res + bit;
+      res = (res >> 1) + bit;
+    } else {
+      res >>= 1;
+    }
+    bit >>= 2;
+  }
+  return (uint32_t)res;
+}
+
+// Length of a Q16.16 vector, exact to 1 LSB.
+static inline fix16 fxHypot(fix16 x, fix16 y) {
+  uint64_t d2 = (uint64_t)((int64_t)x * x) + (uint64_t)((int64_t)y * y);
+  return (fix16)isqrt64(d2);
+}
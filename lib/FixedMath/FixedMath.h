@@ -0,0 +1,79 @@
+// FixedMath - Q16.16 Fixed-Point Arithmetic
+// Integer-only numeric helpers for FPU-less targets (RP2040 / Cortex-M0+)
+#pragma once
+
+#include <stdint.h>
+
+// Q16.16: 16 integer bits (signed), 16 fractional bits.
+// Range is +/-32768 with a resolution of ~1.5e-5, which covers world
+// coordinates, velocities and camera scales used by the game.
+typedef int32_t fix16;
+
+static const int FX_SHIFT = 16;
+static const fix16 FX_ONE = (fix16)1 << FX_SHIFT;
+static const fix16 FX_HALF = FX_ONE >> 1;
+
+// -------------------- CONVERSION --------------------
+// constexpr so that float constants fold to integers at compile time.
+static constexpr fix16 fxFromFloat(float v) {
+  return (fix16)(v * 65536.0f + (v >= 0.0f ? 0.5f : -0.5f));
+}
+
+static constexpr fix16 fxFromInt(int32_t v) {
+  return (fix16)((uint32_t)v << FX_SHIFT);
+}
+
+static inline float fxToFloat(fix16 v) {
+  return (float)v * (1.0f / 65536.0f);
+}
+
+// Round toward negative infinity (arithmetic shift).
+static inline int32_t fxFloor(fix16 v) {
+  return v >> FX_SHIFT;
+}
+
+// Round toward zero, matching a C (int) cast of the float equivalent.
+static inline int32_t fxTrunc(fix16 v) {
+  return (v >= 0) ? (v >> FX_SHIFT) : -((-v) >> FX_SHIFT);
+}
+
+static inline int32_t fxRound(fix16 v) {
+  return (v + FX_HALF) >> FX_SHIFT;
+}
+
+// -------------------- ARITHMETIC --------------------
+static inline fix16 fxMul(fix16 a, fix16 b) {
+  return (fix16)(((int64_t)a * (int64_t)b) >> FX_SHIFT);
+}
+
+static inline fix16 fxDiv(fix16 a, fix16 b) {
+  return (fix16)(((int64_t)a << FX_SHIFT) / (int64_t)b);
+}
+
+// Integer ratio num/den as Q16.16 (e.g. elapsed/duration).
+static inline fix16 fxRatio(int32_t num, int32_t den) {
+  return (fix16)(((int64_t)num << FX_SHIFT) / (int64_t)den);
+}
+
+static inline fix16 fxAbs(fix16 v) {
+  return (v < 0) ? -v : v;
+}
+
+static inline fix16 fxClamp(fix16 v, fix16 lo, fix16 hi) {
+  if (v < lo) return lo;
+  if (v > hi) return hi;
+  return v;
+}
+
+// a + (b - a) * t
+static inline fix16 fxLerp(fix16 a, fix16 b, fix16 t) {
+  return a + fxMul(b - a, t);
+}
+
+// -------------------- INTEGER HELPERS --------------------
+// Floor division for a positive divisor (world cell indexing).
+static inline int32_t floorDivi(int32_t a, int32_t b) {
+  int32_t q = a / b;
+  if ((a % b) != 0 && a < 0) q--;
+  return q;
+}
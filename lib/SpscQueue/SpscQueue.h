@@ -0,0 +1,55 @@
+// SpscQueue - Lock-Free Single-Producer Single-Consumer Ring
+// Safe between an interrupt and the main loop, or between the two RP2040
+// cores, as long as exactly one side pushes and exactly one side pops.
+#pragma once
+
+#include <stdint.h>
+
+// N must be a power of two. Holds up to N items; head and tail are free
+// running counters, so full and empty are told apart without a spare slot.
+template <typename T, uint32_t N>
+class SpscQueue {
+  static_assert(N >= 2 && (N & (N - 1)) == 0, "SpscQueue capacity must be a power of two");
+
+public:
+  SpscQueue() : head(0), tail(0) {}
+
+  // Producer side. Returns false (item dropped) when full.
+  bool push(const T &item) {
+    uint32_t h = head;
+    uint32_t t = __atomic_load_n(&tail, __ATOMIC_ACQUIRE);
+    if (h - t >= N) {
+      dropped++;
+      return false;
+    }
+    items[h & (N - 1)] = item;
+    __atomic_store_n(&head, h + 1, __ATOMIC_RELEASE);
+    return true;
+  }
+
+  // Consumer side. Returns false when empty.
+  bool pop(T &out) {
+    uint32_t t = tail;
+    uint32_t h = __atomic_load_n(&head, __ATOMIC_ACQUIRE);
+    if (h == t) return false;
+    out = items[t & (N - 1)];
+    __atomic_store_n(&tail, t + 1, __ATOMIC_RELEASE);
+    return true;
+  }
+
+  // Either side; a snapshot that may be stale by the time it is used.
+  uint32_t size() const {
+    return __atomic_load_n(&head, __ATOMIC_ACQUIRE) - __atomic_load_n(&tail, __ATOMIC_ACQUIRE);
+  }
+
+  bool empty() const { return size() == 0; }
+
+  // Items rejected because the queue was full (producer-owned counter)
+  uint32_t droppedCount() const { return dropped; }
+
+private:
+  T items[N];
+  uint32_t head;          // Written only by the producer
+  uint32_t tail;          // Written only by the consumer
+  uint32_t dropped = 0;
+};
@@ -0,0 +1,179 @@
+// Pixel Buzz Box - ADC Stream (Free-Running Joystick Sampling)
+#include "game.h"
+
+#if defined(ARDUINO_ARCH_RP2040)
+#include <hardware/adc.h>
+#include <hardware/dma.h>
+#endif
+
+// -------------------- RING LAYOUT --------------------
+// The ADC converts X and Y alternately (round robin) and every conversion
+// lands in a ring of raw 12-bit samples. Sample k belongs to the lower ADC
+// input when k is even, so a pair is always (even, odd) in write order.
+static const int ADC_RING_N = 1 << ADC_RING_BITS;
+static const uint32_t ADC_SAMPLE_PERIOD_US = 1000000u / ADC_SAMPLE_RATE_HZ;
+
+#if defined(ARDUINO_ARCH_RP2040)
+// DMA ring wrapping needs the buffer aligned to its own size
+static uint16_t adcRing[ADC_RING_N] __attribute__((aligned(ADC_RING_N * sizeof(uint16_t))));
+#else
+static uint16_t adcRing[ADC_RING_N];
+#endif
+
+static const uint8_t ADC_INPUT_X = (uint8_t)(PIN_JOY_VRX - 26);
+static const uint8_t ADC_INPUT_Y = (uint8_t)(PIN_JOY_VRY - 26);
+static const bool ADC_X_FIRST = ADC_INPUT_X < ADC_INPUT_Y;
+
+// -------------------- FILTER STATE --------------------
+static int32_t filtX = 0, filtY = 0;    // 12-bit scale, 4 fractional bits
+static bool filtPrimed = false;
+static uint32_t lastPairEnd = 0;        // Samples written at the previous read
+static bool streamRunning = false;
+
+// -------------------- SAMPLE SOURCE --------------------
+#if defined(ARDUINO_ARCH_RP2040)
+static int dmaChan = -1;
+static const uint32_t DMA_START_COUNT = 0xFFFFFFFFu;
+static const uint32_t DMA_RESTART_MARGIN = 1u << 20;   // ~2 min at 8 kHz
+
+static void startConversions() {
+  adc_run(false);
+  dma_channel_abort((uint)dmaChan);
+  adc_fifo_drain();
+  adc_select_input(ADC_X_FIRST ? ADC_INPUT_X : ADC_INPUT_Y);
+
+  dma_channel_config c = dma_channel_get_default_config((uint)dmaChan);
+  channel_config_set_transfer_data_size(&c, DMA_SIZE_16);
+  channel_config_set_read_increment(&c, false);
+  channel_config_set_write_increment(&c, true);
+  channel_config_set_ring(&c, true, ADC_RING_BITS + 1);   // Ring size in bytes
+  channel_config_set_dreq(&c, DREQ_ADC);
+  dma_channel_configure((uint)dmaChan, &c, adcRing, &adc_hw->fifo, DMA_START_COUNT, true);
+
+  adc_run(true);
+  lastPairEnd = 0;
+}
+
+// Samples written since the last (re)start
+static uint32_t samplesWritten() {
+  uint32_t remaining = dma_channel_hw_addr((uint)dmaChan)->transfer_count;
+  if (remaining < DMA_RESTART_MARGIN) {
+    // Days of uptime: restart from a known parity rather than let it stop
+    startConversions();
+    return 0;
+  }
+  return DMA_START_COUNT - remaining;
+}
+
+void adcStreamBegin() {
+  adc_init();
+  adc_gpio_init(PIN_JOY_VRX);
+  adc_gpio_init(PIN_JOY_VRY);
+  adc_set_round_robin((1u << ADC_INPUT_X) | (1u << ADC_INPUT_Y));
+  // FIFO feeds DMA one sample at a time; keep full 12-bit samples
+  adc_fifo_setup(true, true, 1, false, false);
+  adc_set_clkdiv(48000000.0f / (float)ADC_SAMPLE_RATE_HZ - 1.0f);
+
+  dmaChan = dma_claim_unused_channel(true);
+  startConversions();
+  filtPrimed = false;
+  streamRunning = true;
+}
+
+#else
+// Host stand-in: a sample source evaluated on the same timeline the DMA
+// would have produced, so the filter and its lag behave as on hardware.
+static uint16_t analogSource(uint8_t input, uint32_t tUs) {
+  (void)tUs;
+  return (uint16_t)(analogRead(26 + input) << 2);   // 10-bit stub -> 12-bit
+}
+
+static AdcSampleSource hostSource = analogSource;
+static uint32_t hostStartUs = 0;
+static uint32_t hostFilled = 0;
+
+void adcStreamSetSource(AdcSampleSource src) {
+  hostSource = src ? src : analogSource;
+}
+
+static uint32_t samplesWritten() {
+  uint32_t written = (uint32_t)(((uint64_t)(micros() - hostStartUs) * ADC_SAMPLE_RATE_HZ) / 1000000u);
+  if (written - hostFilled > (uint32_t)ADC_RING_N) hostFilled = written - ADC_RING_N;
+  for (; hostFilled < written; hostFilled++) {
+    bool first = (hostFilled & 1u) == 0;
+    uint8_t input = (first == ADC_X_FIRST) ? ADC_INPUT_X : ADC_INPUT_Y;
+    adcRing[hostFilled & (ADC_RING_N - 1)] = hostSource(input, hostStartUs + hostFilled * ADC_SAMPLE_PERIOD_US);
+  }
+  return written;
+}
+
+void adcStreamBegin() {
+  hostStartUs = micros();
+  hostFilled = 0;
+  lastPairEnd = 0;
+  filtPrimed = false;
+  streamRunning = true;
+}
+#endif
+
+// -------------------- IIR GAIN --------------------
+// n single steps of y += (x - y) / N move y by 1 - (1 - 1/N)^n of the way
+// to a steady x; the power is taken by squaring, so any gap costs a few
+// multiplies and the time constant holds however often reads come in.
+static fix16 iirGain(uint32_t n) {
+  fix16 keep = FX_ONE;
+  fix16 base = FX_ONE - FX_ONE / ADC_IIR_PAIRS;
+  while (n && keep) {
+    if (n & 1u) keep = fxMul(keep, base);
+    base = fxMul(base, base);
+    n >>= 1;
+  }
+  return FX_ONE - keep;
+}
+
+// -------------------- CONSUMER --------------------
+// Never blocks: returns false only until the first oversample window has
+// been captured. Values are on the 10-bit scale the input constants use.
+bool adcStreamRead(JoyAxes &out) {
+  if (!streamRunning) adcStreamBegin();
+
+  uint32_t written = samplesWritten();
+  uint32_t pairEnd = written & ~1u;
+  if (pairEnd < (uint32_t)(2 * ADC_OVERSAMPLE)) {
+    if (!filtPrimed) return false;
+    out.x = (int16_t)((filtX + 32) >> 6);
+    out.y = (int16_t)((filtY + 32) >> 6);
+    return true;
+  }
+
+  // Oversample: box average of the newest complete pairs
+  int32_t sumFirst = 0, sumSecond = 0;
+  for (int k = 1; k <= ADC_OVERSAMPLE; k++) {
+    uint32_t i = pairEnd - 2u * (uint32_t)k;
+    sumFirst += adcRing[i & (ADC_RING_N - 1)] & 0x0FFF;
+    sumSecond += adcRing[(i + 1u) & (ADC_RING_N - 1)] & 0x0FFF;
+  }
+  int32_t avgX = ((ADC_X_FIRST ? sumFirst : sumSecond) << 4) / ADC_OVERSAMPLE;
+  int32_t avgY = ((ADC_X_FIRST ? sumSecond : sumFirst) << 4) / ADC_OVERSAMPLE;
+
+  // One-pole IIR, advanced by every pair that arrived since the last read
+  // as if each had stepped it once with this window's average
+  uint32_t newPairs = (pairEnd - lastPairEnd) / 2u;
+  if (pairEnd < lastPairEnd) filtPrimed = false;           // Stream restarted
+  lastPairEnd = pairEnd;
+  if (!filtPrimed) {
+    filtX = avgX;
+    filtY = avgY;
+    filtPrimed = true;
+  } else if (newPairs > 0) {
+    fix16 k = iirGain(newPairs);
+    filtX += fxMul(avgX - filtX, k);
+    filtY += fxMul(avgY - filtY, k);
+  }
+
+  out.x = (int16_t)((filtX + 32) >> 6);
+  out.y = (int16_t)((filtY + 32) >> 6);
+  // Midpoint of the averaged window
+  out.sampledUs = micros() - (uint32_t)ADC_OVERSAMPLE * 2u * ADC_SAMPLE_PERIOD_US / 2u;
+  return true;
+}
@@ -0,0 +1,198 @@
+// Pixel Buzz Box - Audio (Core1 Synth, Event Ring, Motion Mailbox)
+#include "game.h"
+#include "BuzzSynth.h"
+#include "SpscQueue.h"
+
+#if defined(ARDUINO_ARCH_RP2040)
+#include <pico/time.h>
+#else
+#include <atomic>
+#include <chrono>
+#include <thread>
+#endif
+
+// -------------------- SYNTH --------------------
+// Owned by the audio core: begin() runs there, so the DMA refill IRQ is
+// taken on that core and the synth's interrupt masking covers it. The
+// game core only talks to it through the ring and the mailbox below.
+static BuzzSynth buzzer(PIN_BUZZ);
+
+// -------------------- EVENT RING --------------------
+// Game core pushes, audio core pops; applied in posting order.
+static SpscQueue<AudioEvent, AUDIO_EVENT_QUEUE_N> audioEvents;
+LatencyStats audioEventLatency = {0, 0, 0, 0};
+
+static void pushEvent(uint8_t kind, uint8_t mode, uint16_t freq, uint16_t durationMs) {
+  AudioEvent ev = {micros(), kind, mode, freq, durationMs};
+  audioEvents.push(ev);
+}
+
+void audioPost(SndMode mode) {
+  pushEvent(AUDIO_EV_POST, (uint8_t)mode, 0, 0);
+}
+
+void audioUnloadTone(uint16_t freq, uint16_t durationMs) {
+  pushEvent(AUDIO_EV_UNLOAD_TONE, 0, freq, durationMs);
+}
+
+void audioUnloadDone() {
+  pushEvent(AUDIO_EV_UNLOAD_DONE, 0, 0, 0);
+}
+
+void audioStopAll() {
+  pushEvent(AUDIO_EV_STOP_ALL, 0, 0, 0);
+}
+
+void audioResetMotion() {
+  pushEvent(AUDIO_EV_RESET_MOTION, 0, 0, 0);
+}
+
+uint32_t audioEventsDropped() {
+  return audioEvents.droppedCount();
+}
+
+// Read from the game core for diagnostics; may be mid-update
+const SoundQueueStats &audioQueueStats() {
+  return buzzer.queueStats();
+}
+
+static void applyEvent(const AudioEvent &ev, uint32_t nowMs) {
+  switch (ev.kind) {
+    case AUDIO_EV_POST:
+      buzzer.postSound((SndMode)ev.mode, nowMs);
+      break;
+
+    case AUDIO_EV_UNLOAD_TONE:
+      buzzer.playUnloadTone(ev.freq, ev.durationMs);
+      break;
+
+    case AUDIO_EV_UNLOAD_DONE: {
+      SoundState &snd = buzzer.getState();
+      if (snd.lastUnloadFreq > 0) buzzer.setEventTail(nowMs, snd.lastUnloadFreq, EVENT_TAIL_MS);
+      break;
+    }
+
+    case AUDIO_EV_STOP_ALL:
+      buzzer.stopAll();
+      break;
+
+    case AUDIO_EV_RESET_MOTION: {
+      SoundState &snd = buzzer.getState();
+      snd.prevVX = 0;
+      snd.prevVY = 0;
+      snd.heading = 0;
+      snd.turnRateSmooth = 0;
+      snd.accelSmooth = 0;
+      snd.radialAccelSmooth = 0;
+      snd.eventTailUntilMs = 0;
+      snd.ambientEnv = 0;
+      snd.ambientFreqSmooth = 0;
+      snd.lastUnloadFreq = 0;
+      break;
+    }
+  }
+}
+
+// -------------------- MOTION MAILBOX --------------------
+// Sequence lock: odd while the game core is writing. The reader retries
+// until it sees the same even count on both sides of its copy, so it never
+// mixes two velocities and the writer never waits. Fields are copied with
+// word-sized atomic accesses so a torn read is only ever retried.
+static uint32_t motionSeq = 0;
+static AudioMotion motionBox = {0, 0, 0, 0, false};
+
+void audioPublishMotion(const AudioMotion &m) {
+  uint32_t s = motionSeq;
+  __atomic_store_n(&motionSeq, s + 1, __ATOMIC_RELAXED);
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+  __atomic_store_n(&motionBox.wingSpeed, m.wingSpeed, __ATOMIC_RELAXED);
+  __atomic_store_n(&motionBox.vx, m.vx, __ATOMIC_RELAXED);
+  __atomic_store_n(&motionBox.vy, m.vy, __ATOMIC_RELAXED);
+  __atomic_store_n(&motionBox.speed, m.speed, __ATOMIC_RELAXED);
+  __atomic_store_n(&motionBox.active, m.active, __ATOMIC_RELAXED);
+  __atomic_store_n(&motionSeq, s + 2, __ATOMIC_RELEASE);
+}
+
+static void readMotion(AudioMotion &out) {
+  for (;;) {
+    uint32_t s0 = __atomic_load_n(&motionSeq, __ATOMIC_ACQUIRE);
+    if (s0 & 1u) continue;
+    out.wingSpeed = __atomic_load_n(&motionBox.wingSpeed, __ATOMIC_RELAXED);
+    out.vx = __atomic_load_n(&motionBox.vx, __ATOMIC_RELAXED);
+    out.vy = __atomic_load_n(&motionBox.vy, __ATOMIC_RELAXED);
+    out.speed = __atomic_load_n(&motionBox.speed, __ATOMIC_RELAXED);
+    out.active = __atomic_load_n(&motionBox.active, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    if (__atomic_load_n(&motionSeq, __ATOMIC_RELAXED) == s0) return;
+  }
+}
+
+// -------------------- SERVICE --------------------
+// One audio tick: drain the ring, then advance the ambient model and the
+// effect queue on this core's own clock.
+static void audioService(uint32_t nowUs) {
+  static uint32_t lastUs = nowUs;
+  uint32_t dtUs = nowUs - lastUs;
+  lastUs = nowUs;
+  uint32_t nowMs = millis();
+
+  AudioEvent ev;
+  while (audioEvents.pop(ev)) {
+    latencyRecord(audioEventLatency, nowUs - ev.us);
+    applyEvent(ev, nowMs);
+  }
+
+  AudioMotion m;
+  readMotion(m);
+  if (!m.active) return;
+
+  buzzer.updateAmbient(nowMs, dtUs, m.wingSpeed, m.vx, m.vy, m.speed);
+  buzzer.updateSound(nowMs);
+}
+
+void audioCoreSetup() {
+  buzzer.begin();
+}
+
+#if defined(ARDUINO_ARCH_RP2040)
+// -------------------- CORE1 --------------------
+// Started by the core from setup1()/loop1(); nothing to do on core0.
+void audioBegin() {}
+
+// Ticks at AUDIO_PERIOD_US and sleeps in between; falls back in step
+// after a stall instead of bursting to catch up.
+void audioCoreLoop() {
+  static uint32_t nextUs = micros();
+  int32_t waitUs = (int32_t)(nextUs - micros());
+  if (waitUs > 0) sleep_us((uint64_t)waitUs);
+  else if (waitUs < -(int32_t)AUDIO_PERIOD_US) nextUs = micros();
+  nextUs += AUDIO_PERIOD_US;
+  audioService(micros());
+}
+#else
+// -------------------- HOST THREAD --------------------
+// Stand-in for core1: the same service loop on a thread, paced in real
+// time against whatever clock the host tool drives micros() with.
+static std::thread audioThread;
+static std::atomic<bool> audioRunning(false);
+
+void audioCoreLoop() {
+  audioService(micros());
+}
+
+void audioBegin() {
+  if (audioRunning.exchange(true)) return;
+  audioThread = std::thread([] {
+    audioCoreSetup();
+    while (audioRunning.load()) {
+      audioCoreLoop();
+      std::this_thread::sleep_for(std::chrono::microseconds(AUDIO_PERIOD_US));
+    }
+  });
+}
+
+void audioEnd() {
+  if (!audioRunning.exchange(false)) return;
+  audioThread.join();
+}
+#endif
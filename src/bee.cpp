@@ -2,10 +2,10 @@
 #include "game.h"
 #include <math.h>
 
-// -------------------- BEE STATE --------------------
-float beeWX = 0.0f, beeWY = 0.0f;
-float beeVX = 0.0f, beeVY = 0.0f;
-float wingPhase = 0.0f;
+// -------------------- BEE STATE (Q16.16) --------------------
+fix16 beeWX = 0, beeWY = 0;
+fix16 beeVX = 0, beeVY = 0;
+uint32_t wingPhase = 0;
 float wingSpeed = 0.0f;
 
 // -------------------- BOOST STATE --------------------
@@ -21,78 +21,186 @@ bool isBoostOnCooldown(uint32_t nowMs) {
   return (int32_t)(boostCooldownUntilMs - nowMs) > 0;
 }
 
+// Contact between the bee's hit circle and a circle of radius r at (wx, wy);
+// shared by pickups and hazards
+bool beeTouches(int32_t wx, int32_t wy, int32_t r) {
+  int32_t dx = fxTrunc(beeWX) - wx;
+  int32_t dy = fxTrunc(beeWY) - wy;
+  int32_t hitR = r + BEE_HIT_RADIUS;
+  return (dx*dx + dy*dy) <= hitR*hitR;
+}
+
 // -------------------- BOOST CONTROL --------------------
 void triggerAutoBoost(uint32_t nowMs) {
   boostActiveUntilMs = nowMs + BOOST_DURATION_AUTO;
   boostCooldownUntilMs = nowMs + BOOST_COOLDOWN_AUTO;
+  timerArm(TIMER_BOOST, 0, boostActiveUntilMs, nullptr, true);
 }
 
 void triggerManualBoost(uint32_t nowMs) {
   boostActiveUntilMs = nowMs + BOOST_DURATION_MANUAL;
   boostCooldownUntilMs = nowMs + BOOST_COOLDOWN_MANUAL;
+  timerArm(TIMER_BOOST, 0, boostActiveUntilMs, nullptr, true);
+}
+
+// -------------------- SPRING INTEGRATOR --------------------
+// Exact step of e'' = -k e - c v (unit mass, e = position - target) over dt,
+// holding the target fixed. With a = c/2 and A the system matrix,
+// (A + aI)^2 = (a^2 - k) I, so
+//   exp(A dt) = e^(-a dt) * (C I + S (A + aI))
+// where C/S are cos/sin (under-damped), cosh/sinh (over-damped) or 1/dt
+// (critical). The 2x2 result is cached per (k, c, dt) and each step costs
+// four multiplies per axis, unconditionally stable at any dt.
+//
+// The position row is kept in Q2.30: p01 is about dt, and its Q16.16
+// rounding was a fraction of a percent of every step's travel. Both of
+// its entries stay within +/-1 at any dt; the velocity row (m10 grows
+// with k dt) stays Q16.16.
+static const int SPRING_POS_SHIFT = 30;
+
+struct SpringStep {
+  fix16 k, c, dt;           // Cache key
+  int32_t p00, p01;         // e' = p00 e + p01 v   (Q2.30)
+  fix16 m10, m11;           // v' = m10 e + m11 v   (Q16.16)
+};
+
+static const int SPRING_CACHE_N = 4;
+static SpringStep springCache[SPRING_CACHE_N];
+static int springCacheNext = 0;   // Zero-initialized entries have dt = 0 and never match
+
+static void computeSpringStep(SpringStep &st) {
+  float k = fxToFloat(st.k);
+  float c = fxToFloat(st.c);
+  float h = fxToFloat(st.dt);
+  float a = 0.5f * c;
+  float disc = a * a - k;
+
+  float C, S;
+  if (disc < -1e-6f) {
+    float wd = sqrtf(-disc);
+    C = cosf(wd * h);
+    S = sinf(wd * h) / wd;
+  } else if (disc > 1e-6f) {
+    float b = sqrtf(disc);
+    C = coshf(b * h);
+    S = sinhf(b * h) / b;
+  } else {
+    C = 1.0f;
+    S = h;
+  }
+
+  float E = expf(-a * h);
+  st.p00 = (int32_t)lrintf(E * (C + S * a) * (float)(1 << SPRING_POS_SHIFT));
+  st.p01 = (int32_t)lrintf(E * S * (float)(1 << SPRING_POS_SHIFT));
+  st.m10 = fxFromFloat(-E * S * k);
+  st.m11 = fxFromFloat(E * (C - S * a));
+}
+
+static const SpringStep &springStepFor(fix16 k, fix16 c, fix16 dt) {
+  for (int i = 0; i < SPRING_CACHE_N; i++) {
+    const SpringStep &st = springCache[i];
+    if (st.k == k && st.c == c && st.dt == dt) return st;
+  }
+
+  SpringStep &st = springCache[springCacheNext];
+  springCacheNext = (springCacheNext + 1) % SPRING_CACHE_N;
+  st.k = k;
+  st.c = c;
+  st.dt = dt;
+  computeSpringStep(st);
+  return st;
+}
+
+static inline void springAxis(const SpringStep &st, fix16 target, fix16 &x, fix16 &v) {
+  fix16 e = x - target;
+  int64_t p = (int64_t)st.p00 * e + (int64_t)st.p01 * v;
+  fix16 e1 = (fix16)((p + ((int64_t)1 << (SPRING_POS_SHIFT - 1))) >> SPRING_POS_SHIFT);
+  fix16 v1 = fxMul(st.m10, e) + fxMul(st.m11, v);
+  x = target + e1;
+  v = v1;
 }
 
 // -------------------- PHYSICS UPDATE --------------------
-void updateBeePhysics(float nx, float ny, int rawDx, int rawDy, float dt, bool boosting) {
+struct SpringTarget {
+  fix16 wx, wy;     // Target position in world space
+  fix16 k, c;       // Stiffness and damping after carry weight
+};
+
+static void springTargetFor(float nx, float ny, int rawDx, int rawDy, bool boosting, SpringTarget &t) {
   // Joystick maps to target position in world space (bounded exploration area)
-  const float roamRadius = BOUNDARY_COMFORTABLE;
-  float targetWX = nx * roamRadius;
-  float targetWY = ny * roamRadius;
+  static const fix16 roamRadius = fxFromFloat(BOUNDARY_COMFORTABLE);
+  t.wx = fxMul(fxFromFloat(nx), roamRadius);
+  t.wy = fxMul(fxFromFloat(ny), roamRadius);
 
   // When joystick neutral, target snaps to hive center
-  if (rawDx == 0) targetWX = 0.0f;
-  if (rawDy == 0) targetWY = 0.0f;
+  if (rawDx == 0) t.wx = 0;
+  if (rawDy == 0) t.wy = 0;
 
   // Spring constants (higher = more responsive)
-  float springK = boosting ? SPRING_K_BOOST : SPRING_K_NORMAL;
-  float damping = boosting ? DAMPING_BOOST : DAMPING_NORMAL;
+  fix16 springK = boosting ? SPRING_K_BOOST : SPRING_K_NORMAL;
+  fix16 damping = boosting ? DAMPING_BOOST : DAMPING_NORMAL;
 
   // Carry weight penalty: heavier pollen loads feel less agile.
-  float load = clampf((float)pollenCount / (float)MAX_POLLEN_CARRY, 0.0f, 1.0f);
-  springK *= (1.0f - CARRY_WEIGHT_SPRING_PENALTY * load);
-  damping *= (1.0f + CARRY_WEIGHT_DAMPING_PENALTY * load);
+  fix16 load = fxRatio(clampi(pollenCount, 0, MAX_POLLEN_CARRY), MAX_POLLEN_CARRY);
+  t.k = fxMul(springK, FX_ONE - fxMul(CARRY_WEIGHT_SPRING_PENALTY, load));
+  t.c = fxMul(damping, FX_ONE + fxMul(CARRY_WEIGHT_DAMPING_PENALTY, load));
+}
 
-  // Spring force: F = k * (target - current) - damping * velocity
-  float forceX = springK * (targetWX - beeWX) - damping * beeVX;
-  float forceY = springK * (targetWY - beeWY) - damping * beeVY;
+void updateBeePhysics(float nx, float ny, int rawDx, int rawDy, fix16 dt, bool boosting) {
+  SpringTarget t;
+  springTargetFor(nx, ny, rawDx, rawDy, boosting, t);
 
-  beeVX += forceX * dt;
-  beeVY += forceY * dt;
+  // Spring force: F = k * (target - current) - damping * velocity, solved exactly
+  const SpringStep &st = springStepFor(t.k, t.c, dt);
+  springAxis(st, t.wx, beeWX, beeVX);
+  springAxis(st, t.wy, beeWY, beeVY);
+}
 
-  beeWX += beeVX * dt;
-  beeWY += beeVY * dt;
+// Render-only extrapolation of the bee over a short lead using a fresh
+// stick sample. One semi-implicit Euler step: cheap, and accurate enough
+// over a few tens of ms; the simulated state is left untouched.
+void predictBeePosition(const JoystickSample &joy, fix16 lead, bool boosting, fix16 &px, fix16 &py) {
+  SpringTarget t;
+  springTargetFor(joy.nx, joy.ny, joy.rawDx, joy.rawDy, boosting, t);
+
+  fix16 ax = fxMul(t.k, t.wx - beeWX) - fxMul(t.c, beeVX);
+  fix16 ay = fxMul(t.k, t.wy - beeWY) - fxMul(t.c, beeVY);
+  fix16 vx = beeVX + fxMul(ax, lead);
+  fix16 vy = beeVY + fxMul(ay, lead);
+  px = beeWX + fxMul(vx, lead);
+  py = beeWY + fxMul(vy, lead);
 }
 
 // -------------------- WING ANIMATION --------------------
 void updateWingAnimation(float dt) {
-  float sp = fabsf(beeVX) + fabsf(beeVY);
+  float sp = fxToFloat(fxAbs(beeVX) + fxAbs(beeVY));
   float spN = clampf(sp / WING_SPEED_DIVISOR, 0.0f, 1.0f);
   wingSpeed = spN;
   float hz = WING_HZ_MIN + WING_HZ_RANGE * wingSpeed;
-  wingPhase += 2.0f * 3.1415926f * hz * dt;
-  if (wingPhase > WING_PHASE_WRAP) wingPhase -= WING_PHASE_WRAP;
+  // Phase in binary angle units; the low 16 bits wrap cleanly each flap
+  wingPhase += (uint32_t)(hz * dt * 65536.0f);
 }
 
 // -------------------- RESET --------------------
 void resetBee() {
-  beeWX = 0.0f;
-  beeWY = 0.0f;
-  beeVX = 0.0f;
-  beeVY = 0.0f;
-  wingPhase = 0.0f;
+  beeWX = 0;
+  beeWY = 0;
+  beeVX = 0;
+  beeVY = 0;
+  wingPhase = 0;
   wingSpeed = 0.0f;
   boostActiveUntilMs = 0;
   boostCooldownUntilMs = 0;
 }
 
 void stopBeeMovement() {
-  beeWX = 0.0f;
-  beeWY = 0.0f;
-  beeVX = 0.0f;
-  beeVY = 0.0f;
+  beeWX = 0;
+  beeWY = 0;
+  beeVX = 0;
+  beeVY = 0;
   wingSpeed = 0.0f;
 }
 
-float getBeeSpeed() {
-  return sqrtf(beeVX * beeVX + beeVY * beeVY);
+fix16 getBeeSpeed() {
+  return fxHypot(beeVX, beeVY);
 }
@@ -1,16 +1,27 @@
-// Pixel Buzz Box - Flowers (Spawning, Styles, Collection)
+// Pixel Buzz Box - Flowers (Chunk Field, Styles, Collection)
 #include "game.h"
 #include "BuzzSynth.h"
 #include <math.h>
 
-extern BuzzSynth buzzer;
-
 // -------------------- FLOWER STATE --------------------
-Flower flowers[FLOWER_N];
-uint32_t flowerBornMs[FLOWER_N];
+Pool<Flower, FLOWER_N> flowers;
+SpatialHash<FLOWER_N, FLOWER_GRID_BUCKETS, FLOWER_GRID_CELL> flowerGrid;
+
+// -------------------- CHUNK CACHE --------------------
+// Flower sites are a pure function of worldCellSeed(chunk, salt), so a
+// chunk can be dropped and rebuilt at any time. The only per-chunk state
+// is the harvested bitset, so a chunk with picked flowers still waiting
+// to regrow is never evicted: its regrow timer keeps running and the
+// flowers come back on time, not at full bloom when it streams back in.
+static FlowerChunk chunks[FLOWER_CHUNK_CACHE];
+static uint32_t fieldSalt = 0;
+static const int32_t FIELD_OUTER = (int32_t)BOUNDARY_COMFORTABLE - FLOWER_FIELD_MARGIN;
+static uint32_t chunkClock = 0;
+static int32_t streamCX0, streamCY0, streamCX1, streamCY1;   // Resident chunk range
+static bool streamValid = false;
 
 // -------------------- STYLING --------------------
-void initFlowerStyle(Flower &f) {
+void initFlowerStyle(Flower &f, uint32_t seed) {
   struct RGB { uint8_t r, g, b; };
   static const RGB petals[] = {
     {255, 120, 180},
@@ -19,9 +30,11 @@ void initFlowerStyle(Flower &f) {
     {255, 170,  80},
     {120, 255, 170},
   };
-  int pi = irand(0, (int)(sizeof(petals)/sizeof(petals[0])) - 1);
+  uint32_t h = hash32(seed);
+  int pi = (int)(h % (sizeof(petals)/sizeof(petals[0])));
   RGB p = petals[pi];
 
+  f.r = (uint8_t)(FLOWER_RADIUS_MIN + (int)((h >> 8) % (FLOWER_RADIUS_MAX - FLOWER_RADIUS_MIN + 1)));
   f.petal = rgb565(p.r, p.g, p.b);
   uint8_t r2 = (p.r > 52) ? (uint8_t)(p.r - 52) : 0;
   uint8_t g2 = (p.g > 52) ? (uint8_t)(p.g - 52) : 0;
@@ -31,108 +44,295 @@ void initFlowerStyle(Flower &f) {
   f.center = rgb565(255, 235, 130);
 }
 
+// -------------------- SITE PATTERN --------------------
+// Candidate sites are one Poisson-disk pattern, periodic over a chunk
+// (distances wrap around the tile), so every chunk can reuse it and the
+// spacing still holds across chunk edges. Each chunk grows a seeded subset.
+// The next round's pattern is built a few candidates per idle frame, from
+// its own generator: how many frames that takes must not shift the game's
+// RNG stream, or a replayed session would grow a different field.
+struct SitePattern {
+  int16_t x[FLOWER_CHUNK_SLOTS], y[FLOWER_CHUNK_SLOTS];   // Offsets inside the chunk
+  uint8_t n;
+  uint8_t chance;     // Per-site grow chance out of 256
+};
+
+static SitePattern sites;         // This round's pattern
+static SitePattern nextSites;     // Under construction
+static uint8_t nextActive[FLOWER_CHUNK_SLOTS];
+static uint8_t nextActiveN = 0;
+static uint8_t nextTries = 0;
+static bool nextSitesReady = false;
+static uint32_t siteRng = 1;
+
+static uint32_t siteRand() {
+  uint32_t x = siteRng;
+  x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+  return (siteRng = x);
+}
+
+static int32_t wrapTile(int32_t v) {
+  return v - floorDivi(v, FLOWER_CHUNK_SIZE) * FLOWER_CHUNK_SIZE;
+}
+
+static bool siteSpaced(const SitePattern &p, int32_t x, int32_t y) {
+  for (int k = 0; k < p.n; k++) {
+    int32_t dx = x - p.x[k];
+    int32_t dy = y - p.y[k];
+    if (dx < 0) dx = -dx;
+    if (dy < 0) dy = -dy;
+    if (dx > FLOWER_CHUNK_SIZE / 2) dx = FLOWER_CHUNK_SIZE - dx;
+    if (dy > FLOWER_CHUNK_SIZE / 2) dy = FLOWER_CHUNK_SIZE - dy;
+    if (dx*dx + dy*dy < FLOWER_SITE_SPACING * FLOWER_SITE_SPACING) return false;
+  }
+  return true;
+}
+
+static void beginSitePattern() {
+  siteRng = xrnd();
+  nextSites.n = 1;
+  nextSites.x[0] = (int16_t)(siteRand() % FLOWER_CHUNK_SIZE);
+  nextSites.y[0] = (int16_t)(siteRand() % FLOWER_CHUNK_SIZE);
+  nextActive[0] = 0;
+  nextActiveN = 1;
+  nextTries = 0;
+  nextSitesReady = false;
+}
+
+// Bridson's algorithm, at most `budget` candidates per call; true once done
+static bool buildSitePattern(int budget) {
+  while (!nextSitesReady && budget-- > 0) {
+    if (nextActiveN == 0) {
+      // Scale the grow chance so the roamable ring averages the target count
+      static const float ringArea = 3.14159265f * (float)(FIELD_OUTER * FIELD_OUTER - FLOWER_FIELD_INNER * FLOWER_FIELD_INNER);
+      float chunksInRing = ringArea / (float)(FLOWER_CHUNK_SIZE * FLOWER_CHUNK_SIZE);
+      float chance = FLOWER_FIELD_TARGET * 256.0f / (chunksInRing * (float)nextSites.n);
+      nextSites.chance = (uint8_t)clampf(chance, 1.0f, 255.0f);
+      nextSitesReady = true;
+      break;
+    }
+
+    int p = nextActive[nextActiveN - 1];
+    angle16 ang = (angle16)siteRand();
+    int32_t r = FLOWER_SITE_SPACING + (int32_t)(siteRand() % FLOWER_SITE_SPACING);
+    int32_t x = wrapTile(nextSites.x[p] + icosScaled(ang, r));
+    int32_t y = wrapTile(nextSites.y[p] + isinScaled(ang, r));
+
+    if (nextSites.n < FLOWER_CHUNK_SLOTS && siteSpaced(nextSites, x, y)) {
+      nextSites.x[nextSites.n] = (int16_t)x;
+      nextSites.y[nextSites.n] = (int16_t)y;
+      nextActive[nextActiveN++] = nextSites.n++;
+      nextTries = 0;
+    } else if (++nextTries >= FLOWER_SITE_TRIES) {
+      nextActiveN--;
+      nextTries = 0;
+    }
+  }
+  return nextSitesReady;
+}
+
+void prepareFlowerSites() {
+  if (nextSites.n == 0) beginSitePattern();
+  buildSitePattern(FLOWER_SITE_WORK_PER_FRAME);
+}
+
+// -------------------- SITES --------------------
+// Site s of a chunk grows when its seeded roll passes the pattern's chance
+// and it lies in the roamable ring (hive clearance to comfortable boundary).
+static bool flowerSite(int32_t cx, int32_t cy, int s, int32_t &wx, int32_t &wy, uint32_t &seed) {
+  if (s >= sites.n) return false;
+  seed = worldCellSeed(cx, cy, fieldSalt ^ ((uint32_t)(s + 1) * 0x9E3779B9u));
+  if ((seed & 0xFFu) >= sites.chance) return false;
+
+  wx = cx * FLOWER_CHUNK_SIZE + sites.x[s];
+  wy = cy * FLOWER_CHUNK_SIZE + sites.y[s];
+  int32_t d2 = wx * wx + wy * wy;
+  return d2 >= FLOWER_FIELD_INNER * FLOWER_FIELD_INNER && d2 <= FIELD_OUTER * FIELD_OUTER;
+}
+
+// Sites in the whole roamable ring for the current salt
+static int fieldSiteCount() {
+  int n = 0;
+  for (int32_t cy = floorDivi(-FIELD_OUTER, FLOWER_CHUNK_SIZE); cy <= floorDivi(FIELD_OUTER, FLOWER_CHUNK_SIZE); cy++) {
+    for (int32_t cx = floorDivi(-FIELD_OUTER, FLOWER_CHUNK_SIZE); cx <= floorDivi(FIELD_OUTER, FLOWER_CHUNK_SIZE); cx++) {
+      for (int s = 0; s < FLOWER_CHUNK_SLOTS; s++) {
+        int32_t wx, wy;
+        uint32_t seed;
+        if (flowerSite(cx, cy, s, wx, wy, seed)) n++;
+      }
+    }
+  }
+  return n;
+}
+
 // -------------------- SPAWNING --------------------
-void spawnFlowerAt(int i, int32_t wx, int32_t wy) {
+static void growFlower(int ci, int s, bool bloom, uint32_t nowMs) {
+  FlowerChunk &c = chunks[ci];
+  int32_t wx, wy;
+  uint32_t seed;
+  if (!flowerSite(c.cx, c.cy, s, wx, wy, seed)) return;
+
+  int i = flowers.acquire();
+  if (i < 0) return;   // Field denser than the pool: the site stays bare
   Flower &f = flowers[i];
-  f.alive = 1;
-  f.r = (uint8_t)irand(FLOWER_RADIUS_MIN, FLOWER_RADIUS_MAX);
   f.wx = wx;
   f.wy = wy;
-  initFlowerStyle(f);
-  flowerBornMs[i] = millis();
-}
-
-void spawnFlowerNearOrigin(int i) {
-  for (int tries = 0; tries < 60; tries++) {
-    int32_t r = (int32_t)irand(FLOWER_SPAWN_NEAR_DIST_MIN, FLOWER_SPAWN_NEAR_DIST_MAX);
-    int32_t a = (int32_t)irand(0, 359);
-    float ang = (float)a * 0.0174532925f;
-    int32_t wx = (int32_t)(cosf(ang) * (float)r);
-    int32_t wy = (int32_t)(sinf(ang) * (float)r);
-
-    bool ok = true;
-    for (int k = 0; k < i; k++) {
-      int32_t dx = wx - flowers[k].wx;
-      int32_t dy = wy - flowers[k].wy;
-      if ((dx*dx + dy*dy) < (FLOWER_COLLISION_DIST*FLOWER_COLLISION_DIST)) { ok = false; break; }
-    }
-    if (!ok) continue;
+  initFlowerStyle(f, seed);
+  f.chunk = (uint8_t)ci;
+  f.slot = (uint8_t)s;
+  f.bornMs = bloom ? nowMs : nowMs - FLOWER_BLOOM_MS;
+  c.flower[s] = (int8_t)i;
+  flowerGrid.insert(i, wx, wy);
+  if (bloom) emitParticles(EMIT_BLOOM_SPARK, fxFromInt(wx), fxFromInt(wy), 0, 0, 0, 5);
+}
+
+static void removeFlower(int i) {
+  chunks[flowers[i].chunk].flower[flowers[i].slot] = -1;
+  flowerGrid.remove(i);
+  flowers.release(i);
+}
 
-    spawnFlowerAt(i, wx, wy);
-    return;
+// Harvested sites come back together, once the bee is clear of them
+static void regrowChunk(uint16_t ci) {
+  FlowerChunk &c = chunks[ci];
+  uint32_t nowMs = timerNowMs();
+  int32_t bx = fxTrunc(beeWX);
+  int32_t by = fxTrunc(beeWY);
+
+  for (int s = 0; s < FLOWER_CHUNK_SLOTS; s++) {
+    if (!(c.harvested & (1u << s))) continue;
+    int32_t wx, wy;
+    uint32_t seed;
+    flowerSite(c.cx, c.cy, s, wx, wy, seed);
+    int32_t dx = wx - bx;
+    int32_t dy = wy - by;
+    if ((dx*dx + dy*dy) < FLOWER_REGROW_BEE_DIST * FLOWER_REGROW_BEE_DIST) continue;
+    c.harvested &= (uint8_t)~(1u << s);
+    growFlower(ci, s, true, nowMs);
   }
-  // fallback
-  int32_t r = (int32_t)irand(100, 180);
-  int32_t a = (int32_t)irand(0, 359);
-  float ang = (float)a * 0.0174532925f;
-  spawnFlowerAt(i, (int32_t)(cosf(ang) * (float)r), (int32_t)(sinf(ang) * (float)r));
-}
-
-void spawnFlowerElsewhere(int i) {
-  for (int tries = 0; tries < 80; tries++) {
-    int32_t r = (int32_t)irand(FLOWER_SPAWN_ELSEWHERE_DIST_MIN, (int)BOUNDARY_COMFORTABLE - FLOWER_SPAWN_ELSEWHERE_MARGIN);
-    int32_t a = (int32_t)irand(0, 359);
-    float ang = (float)a * 0.0174532925f;
-    int32_t wx = (int32_t)(cosf(ang) * (float)r);
-    int32_t wy = (int32_t)(sinf(ang) * (float)r);
-
-    if ((wx*wx + wy*wy) > (int32_t)(BOUNDARY_COMFORTABLE * BOUNDARY_COMFORTABLE)) continue;
-
-    int32_t dx_bee = wx - (int32_t)beeWX;
-    int32_t dy_bee = wy - (int32_t)beeWY;
-    if ((dx_bee*dx_bee + dy_bee*dy_bee) < (FLOWER_BEE_AVOIDANCE_DIST*FLOWER_BEE_AVOIDANCE_DIST)) continue;
-
-    bool ok = true;
-    for (int k = 0; k < FLOWER_N; k++) {
-      if (k == i) continue;
-      if (!flowers[k].alive) continue;
-      int32_t dx = wx - flowers[k].wx;
-      int32_t dy = wy - flowers[k].wy;
-      if ((dx*dx + dy*dy) < (FLOWER_SPACING_ELSEWHERE*FLOWER_SPACING_ELSEWHERE)) { ok = false; break; }
-    }
-    if (!ok) continue;
+  if (c.harvested) timerArm(TIMER_FLOWER_REGROW, ci, nowMs + FLOWER_REGROW_RETRY_MS, regrowChunk, false);
+}
 
-    spawnFlowerAt(i, wx, wy);
-    return;
+// -------------------- STREAMING --------------------
+static int findChunk(int32_t cx, int32_t cy) {
+  for (int ci = 0; ci < FLOWER_CHUNK_CACHE; ci++) {
+    if (chunks[ci].used && chunks[ci].cx == cx && chunks[ci].cy == cy) return ci;
   }
-  // fallback
-  int32_t r = (int32_t)irand(80, 200);
-  int32_t a = (int32_t)irand(0, 359);
-  float ang = (float)a * 0.0174532925f;
-  spawnFlowerAt(i, (int32_t)(cosf(ang) * (float)r), (int32_t)(sinf(ang) * (float)r));
+  return -1;
+}
+
+// Reuses a free entry, else the least recently streamed one outside the
+// current range with nothing left to regrow. False if every entry is
+// pinned one way or the other.
+static bool loadChunk(int32_t cx, int32_t cy, bool bloom, uint32_t nowMs) {
+  int ci = -1;
+  for (int k = 0; k < FLOWER_CHUNK_CACHE; k++) {
+    if (!chunks[k].used) { ci = k; break; }
+    if (chunks[k].lastUsed == chunkClock || chunks[k].harvested) continue;
+    if (ci < 0 || (int32_t)(chunks[k].lastUsed - chunks[ci].lastUsed) < 0) ci = k;
+  }
+  if (ci < 0) return false;
+
+  FlowerChunk &c = chunks[ci];
+  if (c.used) {
+    for (int s = 0; s < FLOWER_CHUNK_SLOTS; s++) {
+      if (c.flower[s] >= 0) removeFlower(c.flower[s]);
+    }
+  }
+
+  c.cx = cx;
+  c.cy = cy;
+  c.used = true;
+  c.harvested = 0;
+  c.lastUsed = chunkClock;
+  for (int s = 0; s < FLOWER_CHUNK_SLOTS; s++) c.flower[s] = -1;
+  for (int s = 0; s < FLOWER_CHUNK_SLOTS; s++) growFlower(ci, s, bloom, nowMs);
+  return true;
 }
 
-void initFlowers() {
-  for (int i = 0; i < FLOWER_N; i++) {
-    flowers[i].alive = 0;
-    spawnFlowerNearOrigin(i);
+static void streamChunks(int32_t wx, int32_t wy, bool bloom, uint32_t nowMs) {
+  int32_t cx0 = floorDivi(wx - FLOWER_STREAM_RADIUS, FLOWER_CHUNK_SIZE);
+  int32_t cy0 = floorDivi(wy - FLOWER_STREAM_RADIUS, FLOWER_CHUNK_SIZE);
+  int32_t cx1 = floorDivi(wx + FLOWER_STREAM_RADIUS, FLOWER_CHUNK_SIZE);
+  int32_t cy1 = floorDivi(wy + FLOWER_STREAM_RADIUS, FLOWER_CHUNK_SIZE);
+  if (streamValid && cx0 == streamCX0 && cy0 == streamCY0 && cx1 == streamCX1 && cy1 == streamCY1) return;
+  streamCX0 = cx0;
+  streamCY0 = cy0;
+  streamCX1 = cx1;
+  streamCY1 = cy1;
+  streamValid = true;
+
+  // Mark everything still in range first so eviction can't pick it
+  chunkClock++;
+  for (int32_t cy = cy0; cy <= cy1; cy++) {
+    for (int32_t cx = cx0; cx <= cx1; cx++) {
+      int ci = findChunk(cx, cy);
+      if (ci >= 0) chunks[ci].lastUsed = chunkClock;
+    }
+  }
+  for (int32_t cy = cy0; cy <= cy1; cy++) {
+    for (int32_t cx = cx0; cx <= cx1; cx++) {
+      // No room yet: try again next step, once a regrow frees an entry
+      if (findChunk(cx, cy) < 0 && !loadChunk(cx, cy, bloom, nowMs)) streamValid = false;
+    }
   }
 }
 
+// Called every sim step; only does work when the bee crosses into a new
+// chunk range
+void updateFlowerField(uint32_t nowMs) {
+  streamChunks(fxTrunc(beeWX), fxTrunc(beeWY), false, nowMs);
+}
+
+void initFlowers(uint32_t nowMs) {
+  flowers.clear();
+  flowerGrid.clear();
+  for (int ci = 0; ci < FLOWER_CHUNK_CACHE; ci++) chunks[ci].used = false;
+  chunkClock = 0;
+  streamValid = false;
+
+  // This round's site pattern: whatever idle frames built, finished now
+  // (bounded: FLOWER_CHUNK_SLOTS sites x FLOWER_SITE_TRIES candidates)
+  if (nextSites.n == 0) beginSitePattern();
+  while (!buildSitePattern(FLOWER_SITE_TRIES)) {}
+  sites = nextSites;
+  beginSitePattern();
+
+  // New field every round; reroll the rare sparse one
+  do {
+    fieldSalt = xrnd();
+  } while (fieldSiteCount() < FLOWER_FIELD_MIN_SITES);
+  streamChunks(fxTrunc(beeWX), fxTrunc(beeWY), true, nowMs);
+}
+
 // -------------------- COLLECTION --------------------
+static void harvestFlower(int i, uint32_t nowMs) {
+  uint8_t ci = flowers[i].chunk;
+  chunks[ci].harvested |= (uint8_t)(1u << flowers[i].slot);
+  removeFlower(i);
+  timerArm(TIMER_FLOWER_REGROW, ci, nowMs + FLOWER_REGROW_MS, regrowChunk, false);
+}
+
 bool tryCollectPollen(uint32_t nowMs) {
   if (pollenCount >= MAX_POLLEN_CARRY) return false;
   if (isUnloading) return false;
 
-  int32_t bx = (int32_t)beeWX;
-  int32_t by = (int32_t)beeWY;
+  // Only flowers whose largest possible hit circle reaches the bee
+  int16_t near[FLOWER_N];
+  int n = flowerGrid.queryRadius(fxTrunc(beeWX), fxTrunc(beeWY), FLOWER_RADIUS_MAX + BEE_HIT_RADIUS, near, FLOWER_N);
 
-  for (int i = 0; i < FLOWER_N; i++) {
+  for (int k = 0; k < n; k++) {
+    int i = near[k];
     Flower &f = flowers[i];
-    if (!f.alive) continue;
-
-    int32_t dx = bx - f.wx;
-    int32_t dy = by - f.wy;
-    int32_t hitR = (int32_t)f.r + BEE_HIT_RADIUS;
-    if ((dx*dx + dy*dy) <= hitR*hitR) {
+    if (beeTouches(f.wx, f.wy, f.r)) {
       pollenCount++;
-      f.alive = 0;
-      spawnFlowerElsewhere(i);
+      emitParticles(EMIT_POLLEN_SPARKLE, fxFromInt(f.wx), fxFromInt(f.wy), 0, 0, 0, 10);
+      harvestFlower(i, nowMs);
 
       // Auto-boost on flower pickup
       triggerAutoBoost(nowMs);
 
-      if (!buzzer.soundBusy()) buzzer.startSound(SND_POLLEN_CHIRP, nowMs);
+      audioPost(SND_POLLEN_CHIRP);
       return true;
     }
   }
@@ -141,20 +341,7 @@ bool tryCollectPollen(uint32_t nowMs) {
 
 // -------------------- TARGETING --------------------
 bool findNearestFlower(int32_t &outWX, int32_t &outWY) {
-  int best = -1;
-  int64_t bestD2 = 0;
-
-  int32_t bx = (int32_t)beeWX;
-  int32_t by = (int32_t)beeWY;
-
-  for (int i = 0; i < FLOWER_N; i++) {
-    if (!flowers[i].alive) continue;
-    int32_t dx = flowers[i].wx - bx;
-    int32_t dy = flowers[i].wy - by;
-    int64_t d2 = (int64_t)dx * (int64_t)dx + (int64_t)dy * (int64_t)dy;
-    if (best < 0 || d2 < bestD2) { best = i; bestD2 = d2; }
-  }
-
+  int best = flowerGrid.nearest(fxTrunc(beeWX), fxTrunc(beeWY));
   if (best < 0) return false;
   outWX = flowers[best].wx;
   outWY = flowers[best].wy;
@@ -5,8 +5,7 @@
 
 // -------------------- DRAWING PRIMITIVES --------------------
 static void drawBoostAura(Adafruit_GFX &g, int x, int y, uint32_t nowMs) {
-  float t = (float)(nowMs % 900u) / 900.0f;
-  int r = 14 + (int)(4.0f * sinf(t * 6.2831853f));
+  int r = 14 + isinScaled(angleFromTurns(nowMs % 900u, 900u), 4);
   uint16_t c1 = rgb565(255, 210, 60);
   uint16_t c2 = rgb565(255, 240, 140);
   g.drawCircle(x, y, r, c1);
@@ -29,15 +28,15 @@ static void drawPollenSparkles(Adafruit_GFX &g, int x, int y, uint32_t nowMs) {
 
 static void drawBeeShadow(Adafruit_GFX &g, int x, int y) {
   int sy = y + 14;
-  float s = 0.5f + 0.5f * sinf(wingPhase);
+  float s = 0.5f + 0.5f * fastSinf((angle16)wingPhase);
   int rx = 10 + (int)(3 * (1.0f - s)) + (int)(2 * wingSpeed);
   int ry = 3  + (int)(2 * (1.0f - s));
 
   for (int yy = -ry; yy <= ry; yy++) {
-    float yf = (float)yy / (float)ry;
-    float inside = 1.0f - yf * yf;
-    if (inside <= 0.0f) continue;
-    int span = (int)(rx * sqrtf(inside));
+    // rx * sqrt(1 - (yy/ry)^2), exact in integers
+    int inside = ry * ry - yy * yy;
+    if (inside <= 0) continue;
+    int span = (int)isqrt32((uint32_t)(rx * rx * inside)) / ry;
 
     int yrow = sy + yy;
     for (int xx = -span; xx <= span; xx++) {
@@ -51,14 +50,14 @@ static void drawBeeShadow(Adafruit_GFX &g, int x, int y) {
 static void drawPollenOrbit(Adafruit_GFX &g, int x, int y) {
   if (pollenCount == 0) return;
   int count = pollenCount;
-  float base = wingPhase * 1.4f;
+  angle16 base = (angle16)((wingPhase / 5u) * 7u);   // 1.4x wing rate
   int ring = 10 + (count / 3) * 2;
   int ringY = ring - 2;
 
   for (int i = 0; i < count; i++) {
-    float ang = base + (6.2831853f * (float)i) / (float)count;
-    int px = x + (int)(cosf(ang) * (float)ring);
-    int py = y + 5 + (int)(sinf(ang) * (float)ringY);
+    angle16 ang = (angle16)(base + angleFromTurns((uint32_t)i, (uint32_t)count));
+    int px = x + icosScaled(ang, ring);
+    int py = y + 5 + isinScaled(ang, ringY);
     g.fillCircle(px, py, 2, COL_POLLEN);
     g.drawPixel(px + 1, py - 1, COL_POLLEN_HI);
   }
@@ -75,7 +74,7 @@ static void drawBee(Adafruit_GFX &g, int x, int y) {
   uint8_t bodyB = (uint8_t)(40 + (int)(120.0f * load));
   uint16_t body = rgb565(bodyR, bodyG, bodyB);
 
-  float s = sinf(wingPhase);
+  float s = fastSinf((angle16)wingPhase);
   int flap = (int)(s * (2 + (int)(3 * wingSpeed)));
   int wH   = 4 + (int)(2 * (0.5f + 0.5f * s));
   int wW   = 7 + (int)(2 * wingSpeed);
@@ -127,8 +126,7 @@ static void drawHivePulse(Adafruit_GFX &g, int x, int y, uint32_t nowMs) {
   }
 }
 
-static void drawFlower(Adafruit_GFX &g, int x, int y, const Flower &f, uint32_t nowMs, uint32_t bornMs) {
-  if (!f.alive) return;
+static void drawFlower(Adafruit_GFX &g, int x, int y, const Flower &f, uint32_t nowMs) {
   int r = (int)f.r;
 
   // subtle shadow underlay
@@ -155,9 +153,9 @@ static void drawFlower(Adafruit_GFX &g, int x, int y, const Flower &f, uint32_t
   g.drawPixel(x - 2, y - 1, COL_WHITE);
 
   // quick bloom pop on spawn
-  uint32_t age = nowMs - bornMs;
-  if (age < 420) {
-    float t = (float)age / 420.0f;
+  uint32_t age = nowMs - f.bornMs;
+  if (age < FLOWER_BLOOM_MS) {
+    float t = (float)age / (float)FLOWER_BLOOM_MS;
     t = clampf(t, 0.0f, 1.0f);
     int growR = 1 + (int)(t * (float)(r + 2));
     uint16_t bloomCore = rgb565(255, 245, 200);
@@ -184,64 +182,10 @@ static void drawFlower(Adafruit_GFX &g, int x, int y, const Flower &f, uint32_t
   }
 }
 
-// -------------------- TRAIL PARTICLES --------------------
-void drawTrailParticles(Adafruit_GFX &g, int ox, int oy, uint32_t nowMs) {
-  const uint32_t TRAIL_LIFE_MS = 300;
-  for (int i = 0; i < TRAIL_MAX; i++) {
-    if (!trail[i].alive) continue;
-    uint32_t age = nowMs - trail[i].bornMs;
-    if (age > TRAIL_LIFE_MS) continue;
-
-    int sx, sy;
-    worldToScreenF(trail[i].wx, trail[i].wy, sx, sy);
-
-    float t = (float)age / (float)TRAIL_LIFE_MS;
-    float alpha = 1.0f - t * t;
-
-    float speedT = trail[i].speedN;
-    uint8_t baseR = (uint8_t)(255 - (int)(115.0f * speedT));
-    uint8_t baseG = (uint8_t)(220 - (int)(120.0f * speedT));
-    uint8_t baseB = (uint8_t)(60 + (int)(195.0f * speedT));
-
-    uint8_t r = (uint8_t)(baseR * alpha);
-    uint8_t g_val = (uint8_t)(baseG * alpha);
-    uint8_t b = (uint8_t)(baseB * alpha);
-
-    if (alpha > 0.6f) {
-      uint16_t outerGlow = rgb565(r / 3, g_val / 3, b / 3);
-      g.fillCircle(sx + ox, sy + oy, 5, outerGlow);
-
-      uint16_t midGlow = rgb565(r / 2, g_val / 2, b / 2);
-      g.fillCircle(sx + ox, sy + oy, 3, midGlow);
-
-      uint16_t core = rgb565(r, g_val, b);
-      g.fillCircle(sx + ox, sy + oy, 2, core);
-
-      if (trail[i].variant == 0 && alpha > 0.8f) {
-        uint16_t sparkle = rgb565(255, 255, 200);
-        g.drawPixel(sx - 3 + ox, sy + oy, sparkle);
-        g.drawPixel(sx + 3 + ox, sy + oy, sparkle);
-        g.drawPixel(sx + ox, sy - 3 + oy, sparkle);
-        g.drawPixel(sx + ox, sy + 3 + oy, sparkle);
-      }
-    } else if (alpha > 0.3f) {
-      uint16_t midGlow = rgb565(r / 2, g_val / 2, b / 2);
-      g.fillCircle(sx + ox, sy + oy, 3, midGlow);
-
-      uint16_t core = rgb565(r, g_val, b);
-      g.fillCircle(sx + ox, sy + oy, 1, core);
-    } else {
-      uint16_t dim = rgb565(r, g_val, b);
-      g.drawPixel(sx + ox, sy + oy, dim);
-    }
-  }
-}
-
 // -------------------- SCORE POPUPS --------------------
 void drawScorePopups(Adafruit_GFX &g, int ox, int oy, uint32_t nowMs) {
   char buf[8];
-  for (int i = 0; i < SCORE_POPUP_N; i++) {
-    if (!scorePopups[i].alive) continue;
+  for (int i = scorePopups.first(); i >= 0; i = scorePopups.next(i)) {
     uint32_t age = nowMs - scorePopups[i].bornMs;
     if (age > SCORE_POPUP_LIFE_MS) continue;
 
@@ -250,7 +194,9 @@ void drawScorePopups(Adafruit_GFX &g, int ox, int oy, uint32_t nowMs) {
 
     float u = 1.0f - (1.0f - t) * (1.0f - t);
     int floatY = (int)(28.0f * u);
-    int sway = (int)(sinf((float)age * 0.018f + (float)scorePopups[i].driftX) * 2.0f);
+    // sin(age * 0.018 + driftX): 188 angle units per ms, driftX in radians
+    angle16 swayAng = (angle16)(age * 188u + (uint32_t)(scorePopups[i].driftX * 10430));
+    int sway = isinScaled(swayAng, 2);
 
     int cx = (int)scorePopups[i].baseSX + scorePopups[i].driftX + sway;
     int cy = (int)scorePopups[i].baseSY - 6 - floatY;
@@ -301,14 +247,19 @@ void drawScorePopups(Adafruit_GFX &g, int ox, int oy, uint32_t nowMs) {
 
 // -------------------- BACKGROUND --------------------
 static void drawBoundaryZone(Adafruit_GFX &g, int ox, int oy) {
-  int hiveX = beeScreenCX() + ox;
-  int hiveY = beeScreenCY() + oy;
+  static const fix16 boundary = fxFromFloat(BOUNDARY_COMFORTABLE);
+  static const int32_t showDist = (int32_t)(BOUNDARY_COMFORTABLE * 0.6f);
 
-  float distFromCenter = sqrtf(beeWX * beeWX + beeWY * beeWY);
+  int hiveX = cam.centerX + ox;
+  int hiveY = cam.centerY + oy;
 
-  if (distFromCenter > BOUNDARY_COMFORTABLE * 0.6f) {
+  // Compare squared distance in whole world units (no sqrt needed)
+  int32_t bx = fxTrunc(cam.originX);
+  int32_t by = fxTrunc(cam.originY);
+
+  if ((bx * bx + by * by) > showDist * showDist) {
     uint16_t boundaryColor = rgb565(50, 70, 90);
-    g.drawCircle(hiveX, hiveY, (int)(BOUNDARY_COMFORTABLE * cameraZoom), boundaryColor);
+    g.drawCircle(hiveX, hiveY, fxTrunc(fxMul(boundary, cam.zoom)), boundaryColor);
   }
 }
 
@@ -321,23 +272,23 @@ static void drawWorldGrid(Adafruit_GFX &g, int tileX, int tileY, int ox, int oy)
   int sx1 = tileX + CANVAS_W - 1;
   int sy1 = tileY + CANVAS_H - 1;
 
-  int32_t wx0 = (int32_t)(beeWX + (float)(sx0 - beeScreenCX()) / cameraZoom);
-  int32_t wy0 = (int32_t)(beeWY + (float)(sy0 - beeScreenCY()) / cameraZoom);
-  int32_t wx1 = (int32_t)(beeWX + (float)(sx1 - beeScreenCX()) / cameraZoom);
-  int32_t wy1 = (int32_t)(beeWY + (float)(sy1 - beeScreenCY()) / cameraZoom);
+  int32_t wx0 = fxTrunc(cam.originX + (sx0 - cam.centerX) * cam.invZoom);
+  int32_t wy0 = fxTrunc(cam.originY + (sy0 - cam.centerY) * cam.invZoom);
+  int32_t wx1 = fxTrunc(cam.originX + (sx1 - cam.centerX) * cam.invZoom);
+  int32_t wy1 = fxTrunc(cam.originY + (sy1 - cam.centerY) * cam.invZoom);
 
-  int32_t gx0 = (int32_t)floorf((float)wx0 / (float)GRID2) * GRID2;
+  int32_t gx0 = floorDivi(wx0, GRID2) * GRID2;
   for (int32_t gx = gx0; gx <= wx1; gx += GRID2) {
-    int sx = beeScreenCX() + (int)(((float)gx - beeWX) * cameraZoom);
+    int sx = cam.centerX + fxTrunc(fxMul(fxFromInt(gx) - cam.originX, cam.zoom));
     if (sx < sx0 || sx > sx1) continue;
     bool major = ((gx % GRID) == 0);
     uint16_t c = major ? COL_GRID : COL_GRID2;
     g.drawFastVLine(sx + ox, sy0 + oy, CANVAS_H, c);
   }
 
-  int32_t gy0 = (int32_t)floorf((float)wy0 / (float)GRID2) * GRID2;
+  int32_t gy0 = floorDivi(wy0, GRID2) * GRID2;
   for (int32_t gy = gy0; gy <= wy1; gy += GRID2) {
-    int sy = beeScreenCY() + (int)(((float)gy - beeWY) * cameraZoom);
+    int sy = cam.centerY + fxTrunc(fxMul(fxFromInt(gy) - cam.originY, cam.zoom));
     if (sy < sy0 || sy > sy1) continue;
     bool major = ((gy % GRID) == 0);
     uint16_t c = major ? COL_GRID : COL_GRID2;
@@ -346,24 +297,24 @@ static void drawWorldGrid(Adafruit_GFX &g, int tileX, int tileY, int ox, int oy)
 }
 
 static void drawStarLayer(Adafruit_GFX &g, int tileX, int tileY, int ox, int oy,
-                          float parallax, int cell, uint16_t cA, uint16_t cB, uint32_t salt) {
-  float camX = beeWX * parallax;
-  float camY = beeWY * parallax;
+                          fix16 parallax, int cell, uint16_t cA, uint16_t cB, uint32_t salt) {
+  fix16 camX = fxMul(cam.originX, parallax);
+  fix16 camY = fxMul(cam.originY, parallax);
 
   int sx0 = tileX;
   int sy0 = tileY;
   int sx1 = tileX + CANVAS_W - 1;
   int sy1 = tileY + CANVAS_H - 1;
 
-  int32_t wx0 = (int32_t)(camX + (float)(sx0 - beeScreenCX()) / cameraZoom);
-  int32_t wy0 = (int32_t)(camY + (float)(sy0 - beeScreenCY()) / cameraZoom);
-  int32_t wx1 = (int32_t)(camX + (float)(sx1 - beeScreenCX()) / cameraZoom);
-  int32_t wy1 = (int32_t)(camY + (float)(sy1 - beeScreenCY()) / cameraZoom);
+  int32_t wx0 = fxTrunc(camX + (sx0 - cam.centerX) * cam.invZoom);
+  int32_t wy0 = fxTrunc(camY + (sy0 - cam.centerY) * cam.invZoom);
+  int32_t wx1 = fxTrunc(camX + (sx1 - cam.centerX) * cam.invZoom);
+  int32_t wy1 = fxTrunc(camY + (sy1 - cam.centerY) * cam.invZoom);
 
-  int32_t cx0 = (int32_t)floorf((float)wx0 / (float)cell);
-  int32_t cy0 = (int32_t)floorf((float)wy0 / (float)cell);
-  int32_t cx1 = (int32_t)floorf((float)wx1 / (float)cell);
-  int32_t cy1 = (int32_t)floorf((float)wy1 / (float)cell);
+  int32_t cx0 = floorDivi(wx0, cell);
+  int32_t cy0 = floorDivi(wy0, cell);
+  int32_t cx1 = floorDivi(wx1, cell);
+  int32_t cy1 = floorDivi(wy1, cell);
 
   for (int32_t cy = cy0; cy <= cy1; cy++) {
     for (int32_t cx = cx0; cx <= cx1; cx++) {
@@ -376,8 +327,8 @@ static void drawStarLayer(Adafruit_GFX &g, int tileX, int tileY, int ox, int oy,
       int32_t wx = cx * cell + px;
       int32_t wy = cy * cell + py;
 
-      int sx = beeScreenCX() + (int)(((float)wx - camX) * cameraZoom);
-      int sy = beeScreenCY() + (int)(((float)wy - camY) * cameraZoom);
+      int sx = cam.centerX + fxTrunc(fxMul(fxFromInt(wx) - camX, cam.zoom));
+      int sy = cam.centerY + fxTrunc(fxMul(fxFromInt(wy) - camY, cam.zoom));
 
       if (sx < sx0 || sx > sx1 || sy < sy0 || sy > sy1) continue;
 
@@ -393,10 +344,12 @@ static void drawStarLayer(Adafruit_GFX &g, int tileX, int tileY, int ox, int oy,
 }
 
 static void drawNebulaLayer(Adafruit_GFX &g, int tileX, int tileY, int ox, int oy, uint32_t nowMs) {
-  float driftX = sinf((float)nowMs * 0.00012f) * 22.0f;
-  float driftY = cosf((float)nowMs * 0.00010f) * 18.0f;
-  float camX = beeWX * 0.35f + driftX;
-  float camY = beeWY * 0.35f + driftY;
+  static const fix16 parallax = fxFromFloat(0.35f);
+  // 0.00012 and 0.00010 rad/ms as (angle units << 12) per ms
+  fix16 driftX = fxSin((angle16)((nowMs * 5127u) >> 12)) * 22;
+  fix16 driftY = fxCos((angle16)((nowMs * 4272u) >> 12)) * 18;
+  fix16 camX = fxMul(cam.originX, parallax) + driftX;
+  fix16 camY = fxMul(cam.originY, parallax) + driftY;
   const int cell = 64;
 
   int sx0 = tileX;
@@ -404,15 +357,15 @@ static void drawNebulaLayer(Adafruit_GFX &g, int tileX, int tileY, int ox, int o
   int sx1 = tileX + CANVAS_W - 1;
   int sy1 = tileY + CANVAS_H - 1;
 
-  int32_t wx0 = (int32_t)(camX + (float)(sx0 - beeScreenCX()) / cameraZoom);
-  int32_t wy0 = (int32_t)(camY + (float)(sy0 - beeScreenCY()) / cameraZoom);
-  int32_t wx1 = (int32_t)(camX + (float)(sx1 - beeScreenCX()) / cameraZoom);
-  int32_t wy1 = (int32_t)(camY + (float)(sy1 - beeScreenCY()) / cameraZoom);
+  int32_t wx0 = fxTrunc(camX + (sx0 - cam.centerX) * cam.invZoom);
+  int32_t wy0 = fxTrunc(camY + (sy0 - cam.centerY) * cam.invZoom);
+  int32_t wx1 = fxTrunc(camX + (sx1 - cam.centerX) * cam.invZoom);
+  int32_t wy1 = fxTrunc(camY + (sy1 - cam.centerY) * cam.invZoom);
 
-  int32_t cx0 = (int32_t)floorf((float)wx0 / (float)cell);
-  int32_t cy0 = (int32_t)floorf((float)wy0 / (float)cell);
-  int32_t cx1 = (int32_t)floorf((float)wx1 / (float)cell);
-  int32_t cy1 = (int32_t)floorf((float)wy1 / (float)cell);
+  int32_t cx0 = floorDivi(wx0, cell);
+  int32_t cy0 = floorDivi(wy0, cell);
+  int32_t cx1 = floorDivi(wx1, cell);
+  int32_t cy1 = floorDivi(wy1, cell);
 
   for (int32_t cy = cy0; cy <= cy1; cy++) {
     for (int32_t cx = cx0; cx <= cx1; cx++) {
@@ -424,8 +377,8 @@ static void drawNebulaLayer(Adafruit_GFX &g, int tileX, int tileY, int ox, int o
       int32_t wx = cx * cell + px;
       int32_t wy = cy * cell + py;
 
-      int sx = beeScreenCX() + (int)(((float)wx - camX) * cameraZoom);
-      int sy = beeScreenCY() + (int)(((float)wy - camY) * cameraZoom);
+      int sx = cam.centerX + fxTrunc(fxMul(fxFromInt(wx) - camX, cam.zoom));
+      int sy = cam.centerY + fxTrunc(fxMul(fxFromInt(wy) - camY, cam.zoom));
       if (sx < sx0 || sx > sx1 || sy < sy0 || sy > sy1) continue;
 
       uint8_t r = clampu8(40 + (int)((h >> 12) & 0x1Fu));
@@ -443,8 +396,8 @@ static void drawNebulaLayer(Adafruit_GFX &g, int tileX, int tileY, int ox, int o
 }
 
 static void drawScreenAnchor(Adafruit_GFX &g, int ox, int oy, uint32_t nowMs) {
-  int cx = beeScreenCX() + ox;
-  int cy = beeScreenCY() + oy;
+  int cx = cam.centerX + ox;
+  int cy = cam.centerY + oy;
   uint16_t c = rgb565(40, 70, 90);
 
   g.drawFastHLine(cx - 26, cy, 12, c);
@@ -452,8 +405,7 @@ static void drawScreenAnchor(Adafruit_GFX &g, int ox, int oy, uint32_t nowMs) {
   g.drawFastVLine(cx, cy - 26, 12, c);
   g.drawFastVLine(cx, cy + 15, 12, c);
 
-  float t = (float)(nowMs % 1200u) / 1200.0f;
-  int r = 22 + (int)(6.0f * sinf(t * 6.2831853f));
+  int r = 22 + isinScaled(angleFromTurns(nowMs % 1200u, 1200u), 6);
   g.drawCircle(cx, cy, r, rgb565(35, 55, 70));
 }
 
@@ -561,8 +513,7 @@ static void drawBeltHUD(Adafruit_GFX &g, int ox, int oy, uint32_t nowMs) {
   g.drawLine(txA + ox, ty + oy, txB + ox, ty + oy, rgb565(34, 54, 34));
   g.drawLine(txA + ox, ty + 2 + oy, txB + ox, ty + 2 + oy, rgb565(22, 34, 22));
 
-  for (int i = 0; i < BELT_ITEM_N; i++) {
-    if (!beltItems[i].alive) continue;
+  for (int i = beltItems.first(); i >= 0; i = beltItems.next(i)) {
     uint32_t age = nowMs - beltItems[i].bornMs;
     if (age > BELT_LIFE_MS) continue;
 
@@ -702,7 +653,7 @@ static void drawGameOver(Adafruit_GFX &g, int ox, int oy) {
   if ((millis() % 800) < 400) {
     g.setTextSize(1);
     g.setTextColor(COL_UI_GO);
-    const char* playAgainText = "Press to play again";
+    const char* playAgainText = ((millis() % 3200) < 1600) ? "Press to play again" : "Hold up + press: wasps";
     int playAgainW = (int)strlen(playAgainText) * 6;
     int playAgainX = panelX + (panelW - playAgainW) / 2;
     g.setCursor(playAgainX + ox, panelY + 82 + oy);
@@ -729,22 +680,22 @@ static void drawGameOver(Adafruit_GFX &g, int ox, int oy) {
 }
 
 static void drawRadarOverlay(Adafruit_GFX &g, int ox, int oy, uint32_t nowMs) {
-  if (!radarActive) return;
-  if ((int32_t)(nowMs - radarUntilMs) >= 0) { radarActive = false; return; }
+  // Frames can run ahead of the sim; TIMER_RADAR ends the ping on its clock
+  if (!radarActive || (int32_t)(nowMs - radarUntilMs) >= 0) return;
 
-  int cx = beeScreenCX() + ox;
-  int cy = beeScreenCY() + oy;
+  int cx = cam.centerX + ox;
+  int cy = cam.centerY + oy;
 
-  float t = 1.0f - (float)(radarUntilMs - nowMs) / 320.0f;
+  float t = 1.0f - (float)(radarUntilMs - nowMs) / (float)RADAR_DURATION_MS;
   t = clampf(t, 0.0f, 1.0f);
 
-  float dx = (float)radarTargetWX - beeWX;
-  float dy = (float)radarTargetWY - beeWY;
-  float len = sqrtf(dx*dx + dy*dy);
+  int32_t idx = radarTargetWX - fxTrunc(cam.originX);
+  int32_t idy = radarTargetWY - fxTrunc(cam.originY);
+  int32_t ilen = (int32_t)isqrt32((uint32_t)(idx * idx + idy * idy));
 
-  if (len < 1.0f) len = 1.0f;
-  float ux = dx / len;
-  float uy = dy / len;
+  float len = (ilen < 1) ? 1.0f : (float)ilen;
+  float ux = (float)idx / len;
+  float uy = (float)idy / len;
 
   int r0 = 14 + (int)(t * 26.0f);
   uint16_t rc = radarToHive ? COL_HIVE : COL_YEL;
@@ -786,8 +737,28 @@ static void drawRadarOverlay(Adafruit_GFX &g, int ox, int oy, uint32_t nowMs) {
 
 // -------------------- RENDER FRAME --------------------
 void renderFrame(uint32_t nowMs) {
+  static const fix16 farParallax = fxFromFloat(0.25f);
+  static const fix16 nearParallax = fxFromFloat(0.55f);
+
   int hiveSX, hiveSY;
   worldToScreen(0, 0, hiveSX, hiveSY);
+  projectParticles();
+  projectWasps();
+
+  // Flowers in the view (plus a 30px margin), culled once for all tiles
+  int32_t vx0 = fxTrunc(cam.originX + (-30 - cam.centerX) * cam.invZoom);
+  int32_t vy0 = fxTrunc(cam.originY + (HUD_H - 30 - cam.centerY) * cam.invZoom);
+  int32_t vx1 = fxTrunc(cam.originX + (tft.width() + 30 - cam.centerX) * cam.invZoom);
+  int32_t vy1 = fxTrunc(cam.originY + (tft.height() + 30 - cam.centerY) * cam.invZoom);
+  int16_t visibleFlowers[FLOWER_N];
+  int16_t flowerSX[FLOWER_N], flowerSY[FLOWER_N];
+  int visibleFlowerN = flowerGrid.queryRect(vx0 - 1, vy0 - 1, vx1 + 1, vy1 + 1, visibleFlowers, FLOWER_N);
+  for (int k = 0; k < visibleFlowerN; k++) {
+    int sx, sy;
+    worldToScreen(flowers[visibleFlowers[k]].wx, flowers[visibleFlowers[k]].wy, sx, sy);
+    flowerSX[k] = (int16_t)sx;
+    flowerSY[k] = (int16_t)sy;
+  }
 
   for (int tileY = 0; tileY < tft.height(); tileY += CANVAS_H) {
     for (int tileX = 0; tileX < tft.width(); tileX += CANVAS_W) {
@@ -800,8 +771,8 @@ void renderFrame(uint32_t nowMs) {
         canvas.fillRect(0, 0, CANVAS_W, CANVAS_H, COL_BG1);
       }
 
-      drawStarLayer(canvas, tileX, tileY, ox, oy, 0.25f, 48,  COL_STAR2, COL_STAR3, 0xA11CEu);
-      drawStarLayer(canvas, tileX, tileY, ox, oy, 0.55f, 36,  COL_STAR,  COL_STAR2, 0xBEEFu);
+      drawStarLayer(canvas, tileX, tileY, ox, oy, farParallax, 48,  COL_STAR2, COL_STAR3, 0xA11CEu);
+      drawStarLayer(canvas, tileX, tileY, ox, oy, nearParallax, 36,  COL_STAR,  COL_STAR2, 0xBEEFu);
       drawNebulaLayer(canvas, tileX, tileY, ox, oy, nowMs);
       drawWorldGrid(canvas, tileX, tileY, ox, oy);
       drawBoundaryZone(canvas, ox, oy);
@@ -812,19 +783,21 @@ void renderFrame(uint32_t nowMs) {
         drawHivePulse(canvas, hiveSX + ox, hiveSY + oy, nowMs);
       }
 
-      for (int i = 0; i < FLOWER_N; i++) {
-        if (!flowers[i].alive) continue;
-        int sx, sy;
-        worldToScreen(flowers[i].wx, flowers[i].wy, sx, sy);
-        if (sx < -30 || sx > tft.width() + 30 || sy < HUD_H - 30 || sy > tft.height() + 30) continue;
-        drawFlower(canvas, sx + ox, sy + oy, flowers[i], nowMs, flowerBornMs[i]);
+      for (int k = 0; k < visibleFlowerN; k++) {
+        int fx = flowerSX[k] + ox;
+        int fy = flowerSY[k] + oy;
+        if (fx < -FLOWER_RADIUS_MAX * 3 || fx > CANVAS_W + FLOWER_RADIUS_MAX * 3 ||
+            fy < -FLOWER_RADIUS_MAX * 3 || fy > CANVAS_H + FLOWER_RADIUS_MAX * 3) continue;
+        drawFlower(canvas, fx, fy, flowers[visibleFlowers[k]], nowMs);
       }
 
-      drawTrailParticles(canvas, ox, oy, nowMs);
+      drawWasps(canvas, ox, oy, nowMs);
+      drawParticles(canvas, ox, oy);
 
-      int bcX = beeScreenCX();
-      int bcY = beeScreenCY();
-      int bob = (int)(sinf((float)nowMs * 0.008f) * 2.0f);
+      int bcX = cam.centerX;
+      int bcY = cam.centerY;
+      // 0.008 rad/ms = 83.44 angle units per ms (5340 >> 6)
+      int bob = isinScaled((angle16)((nowMs * 5340u) >> 6), 2);
       if ((int32_t)(nowMs - boostActiveUntilMs) < 0) {
         drawBoostAura(canvas, bcX + ox, bcY + oy + bob, nowMs);
       }
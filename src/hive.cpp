@@ -1,8 +1,5 @@
 // Pixel Buzz Box - Hive (Unloading, Belt, Deposits)
 #include "game.h"
-#include "BuzzSynth.h"
-
-extern BuzzSynth buzzer;
 
 // -------------------- UNLOAD STATE --------------------
 bool isUnloading = false;
@@ -15,36 +12,17 @@ uint8_t depositsTowardBoost = 0;
 uint8_t boostCharge = 0;
 
 // -------------------- BELT STATE --------------------
-BeltItem beltItems[BELT_ITEM_N];
+Pool<BeltItem, BELT_ITEM_N> beltItems;
 
 // -------------------- BELT FUNCTIONS --------------------
-void spawnBeltItem(uint32_t nowMs) {
-  int freeIdx = -1;
-  uint32_t oldest = 0xFFFFFFFFu;
-  int oldestIdx = 0;
-
-  for (int i = 0; i < BELT_ITEM_N; i++) {
-    if (!beltItems[i].alive) { freeIdx = i; break; }
-    if (beltItems[i].bornMs < oldest) { oldest = beltItems[i].bornMs; oldestIdx = i; }
-  }
-
-  int idx = (freeIdx >= 0) ? freeIdx : oldestIdx;
-  beltItems[idx].alive = 1;
-  beltItems[idx].bornMs = nowMs;
+static void expireBeltItem(uint16_t idx) {
+  beltItems.release(idx);
 }
 
-void updateBeltLifetimes(uint32_t nowMs) {
-  for (int i = 0; i < BELT_ITEM_N; i++) {
-    if (!beltItems[i].alive) continue;
-    if ((uint32_t)(nowMs - beltItems[i].bornMs) > BELT_LIFE_MS) beltItems[i].alive = 0;
-  }
-}
-
-bool anyBeltAlive() {
-  for (int i = 0; i < BELT_ITEM_N; i++) {
-    if (beltItems[i].alive) return true;
-  }
-  return false;
+void spawnBeltItem(uint32_t nowMs) {
+  int idx = beltItems.acquireOrEvict();
+  beltItems[idx].bornMs = nowMs;
+  timerArm(TIMER_BELT_ITEM, (uint16_t)idx, nowMs + BELT_LIFE_MS + 1, expireBeltItem, true);
 }
 
 // -------------------- UNLOAD SEQUENCE --------------------
@@ -54,7 +32,7 @@ void beginUnload(uint32_t nowMs) {
   unloadRemaining = pollenCount;
   unloadTotal = pollenCount;
   unloadNextMs = nowMs;
-  buzzer.stopAll();
+  // Effects posted before now stay queued; the chirps cut the one playing
 }
 
 void updateUnload(uint32_t nowMs) {
@@ -64,7 +42,7 @@ void updateUnload(uint32_t nowMs) {
   if (unloadRemaining > 0) {
     uint8_t stepIndex = (uint8_t)(unloadTotal - unloadRemaining);
     uint16_t freq = (uint16_t)(UNLOAD_CHIRP_BASE + (uint16_t)stepIndex * UNLOAD_CHIRP_STEP);
-    buzzer.playUnloadTone(freq, UNLOAD_CHIRP_MS);
+    audioUnloadTone(freq, UNLOAD_CHIRP_MS);
     unloadRemaining--;
     pollenCount = unloadRemaining;
     score = (uint16_t)(score + 1);
@@ -83,10 +61,7 @@ void updateUnload(uint32_t nowMs) {
   isUnloading = false;
   unloadRemaining = 0;
 
-  SoundState& snd = buzzer.getState();
-  if (snd.lastUnloadFreq > 0.0f) {
-    buzzer.setEventTail(nowMs, snd.lastUnloadFreq, EVENT_TAIL_MS);
-  }
+  audioUnloadDone();
 
   if (unloadTotal > 0) {
     int hiveSX, hiveSY;
@@ -101,8 +76,8 @@ void tryStoreAtHive(uint32_t nowMs) {
   if (pollenCount == 0) return;
   if (isUnloading) return;
 
-  int32_t bx = (int32_t)beeWX;
-  int32_t by = (int32_t)beeWY;
+  int32_t bx = fxTrunc(beeWX);
+  int32_t by = fxTrunc(beeWY);
 
   if ((bx*bx + by*by) <= (HIVE_COLLECTION_RADIUS*HIVE_COLLECTION_RADIUS)) {
     beginUnload(nowMs);
@@ -116,5 +91,5 @@ void resetHive() {
   unloadTotal = 0;
   depositsTowardBoost = 0;
   boostCharge = 0;
-  for (int i = 0; i < BELT_ITEM_N; i++) beltItems[i].alive = 0;
+  beltItems.clear();
 }
@@ -1,16 +1,53 @@
 // Pixel Buzz Box - Input (Joystick and Buttons)
 #include "game.h"
+#include "SpscQueue.h"
+
+#if defined(ARDUINO_ARCH_RP2040)
+#include <EEPROM.h>
+#endif
 
 // -------------------- INPUT STATE --------------------
 int joyCenterX = JOY_CENTER_DEFAULT;
 int joyCenterY = JOY_CENTER_DEFAULT;
 int joyMinY = 1023;
 int joyMaxY = 0;
-bool btnPrev = false;
+
+// -------------------- CALIBRATION STATE --------------------
+// Persisted center and observed Y extremes; refined while the stick rests
+// during the first seconds of play and written back at game over.
+struct StoredCalibration {
+  uint32_t magic;
+  int16_t centerX, centerY;
+  int16_t minY, maxY;
+  uint32_t check;
+};
+
+static const uint32_t JOY_CAL_MAGIC = 0x4A4F5931u;   // "JOY1"
+static StoredCalibration storedCal = {0, 0, 0, 0, 0, 0};
+static bool calStored = false;
+static int32_t refineX = 0, refineY = 0;             // Centers, 4 fractional bits
+static uint32_t refineUntilMs = 0;
+
+// -------------------- BUTTON STATE --------------------
+// Owned by the pin-change interrupt; the main side only reads it, or
+// writes it with interrupts masked
+static volatile bool btnState = false;
+static volatile uint32_t btnLastEdgeUs = 0;
+static SpscQueue<ButtonEvent, BUTTON_QUEUE_N> buttonQueue;
+
+// -------------------- LATCHED INPUT --------------------
+JoystickSample joyLatest = {0.0f, 0.0f, 0, 0, JOY_CENTER_DEFAULT, JOY_CENTER_DEFAULT, 0};
+static bool clickPending = false;
+static uint32_t clickPressUs = 0;
+LatencyStats clickToResponse = {0, 0, 0, 0};
 
 // -------------------- RAW READING --------------------
-int readJoyX() { return analogRead(PIN_JOY_VRX); }
-int readJoyY() { return analogRead(PIN_JOY_VRY); }
+// Axes come from the free-running ADC stream, already oversampled and
+// filtered; reading never waits on a conversion.
+static JoyAxes joyAxes = {JOY_CENTER_DEFAULT, JOY_CENTER_DEFAULT, 0};
+
+int readJoyX() { adcStreamRead(joyAxes); return joyAxes.x; }
+int readJoyY() { adcStreamRead(joyAxes); return joyAxes.y; }
 bool joyPressedRaw() { return digitalRead(PIN_JOY_SW) == LOW; }
 
 // -------------------- PROCESSING --------------------
@@ -20,27 +57,105 @@ int applyDeadzone(int v, int center, int dz) {
   return d;
 }
 
-void calibrateJoystick() {
-  long sx = 0, sy = 0;
-  delay(JOY_CALIBRATION_DELAY_MS);
-  for (int i = 0; i < JOY_CALIBRATION_SAMPLES; i++) {
-    sx += readJoyX();
-    sy += readJoyY();
-    delay(LOOP_DELAY_MS);
+// -------------------- CALIBRATION --------------------
+static uint32_t calibrationCheck(const StoredCalibration &c) {
+  uint32_t h = hash32(c.magic ^ (uint32_t)(uint16_t)c.centerX);
+  h = hash32(h ^ ((uint32_t)(uint16_t)c.centerY << 16));
+  h = hash32(h ^ (uint32_t)(uint16_t)c.minY);
+  return hash32(h ^ ((uint32_t)(uint16_t)c.maxY << 16));
+}
+
+static bool loadCalibration(StoredCalibration &c) {
+#if defined(ARDUINO_ARCH_RP2040)
+  EEPROM.begin(JOY_CAL_EEPROM_SIZE);
+  EEPROM.get(0, c);
+  if (c.magic != JOY_CAL_MAGIC || c.check != calibrationCheck(c)) return false;
+  // Reject anything a real stick could not have produced
+  if (c.centerX < JOY_RANGE / 2 || c.centerX > JOY_RANGE * 3 / 2) return false;
+  if (c.centerY < JOY_RANGE / 2 || c.centerY > JOY_RANGE * 3 / 2) return false;
+  return c.minY <= c.centerY && c.maxY >= c.centerY;
+#else
+  (void)c;
+  return false;
+#endif
+}
+
+// Returns true when the calibration came from flash. Otherwise the center
+// is seeded from the ADC stream's first filtered window (a few ms) and
+// refined in the background; nothing here waits on a sampling loop.
+bool beginJoystickCalibration(uint32_t nowMs) {
+  calStored = loadCalibration(storedCal);
+  if (calStored) {
+    joyCenterX = storedCal.centerX;
+    joyCenterY = storedCal.centerY;
+    joyMinY = storedCal.minY;
+    joyMaxY = storedCal.maxY;
+  } else {
+    JoyAxes a;
+    uint32_t startUs = micros();
+    while (!adcStreamRead(a) && (uint32_t)(micros() - startUs) < JOY_CAL_SEED_TIMEOUT_US) {
+      delayMicroseconds(250);
+    }
+    if (adcStreamRead(a)) {
+      joyCenterX = a.x;
+      joyCenterY = a.y;
+    }
+    joyMinY = joyCenterY;
+    joyMaxY = joyCenterY;
   }
-  joyCenterX = (int)(sx / JOY_CALIBRATION_SAMPLES);
-  joyCenterY = (int)(sy / JOY_CALIBRATION_SAMPLES);
+
+  refineX = (int32_t)joyCenterX << 4;
+  refineY = (int32_t)joyCenterY << 4;
+  refineUntilMs = nowMs + JOY_REFINE_WINDOW_MS;
+  return calStored;
 }
 
-// -------------------- NORMALIZED INPUT --------------------
-void readNormalizedJoystick(float &nx, float &ny, int &rawDx, int &rawDy) {
-  int rawX = readJoyX();
-  int rawY = readJoyY();
+// Track the resting position while the stick sits inside the deadzone
+static void refineCalibration(int rawX, int rawY) {
+  if ((int32_t)(millis() - refineUntilMs) >= 0) return;
+  if (abs(rawX - joyCenterX) >= JOY_DEADZONE || abs(rawY - joyCenterY) >= JOY_DEADZONE) return;
 
-  // Update observed extremes for Y (helps asymmetry)
-  if (rawY < joyMinY) joyMinY = rawY;
-  if (rawY > joyMaxY) joyMaxY = rawY;
+  refineX += (((int32_t)rawX << 4) - refineX) >> JOY_REFINE_SHIFT;
+  refineY += (((int32_t)rawY << 4) - refineY) >> JOY_REFINE_SHIFT;
+  joyCenterX = (int)((refineX + 8) >> 4);
+  joyCenterY = (int)((refineY + 8) >> 4);
+  if (joyMinY > joyCenterY) joyMinY = joyCenterY;
+  if (joyMaxY < joyCenterY) joyMaxY = joyCenterY;
+}
+
+// Writes only when something moved by more than noise, to spare the flash.
+// The write stalls the CPU for a few ms; call it where a hitch is invisible.
+void saveJoystickCalibration() {
+  if (traceReplaying()) return;   // Recorded calibration, not this stick's
 
+  StoredCalibration c;
+  c.magic = JOY_CAL_MAGIC;
+  c.centerX = (int16_t)joyCenterX;
+  c.centerY = (int16_t)joyCenterY;
+  c.minY = (int16_t)joyMinY;
+  c.maxY = (int16_t)joyMaxY;
+  c.check = calibrationCheck(c);
+
+  if (calStored
+      && abs(c.centerX - storedCal.centerX) < JOY_CAL_SAVE_THRESHOLD
+      && abs(c.centerY - storedCal.centerY) < JOY_CAL_SAVE_THRESHOLD
+      && abs(c.minY - storedCal.minY) < JOY_CAL_SAVE_THRESHOLD
+      && abs(c.maxY - storedCal.maxY) < JOY_CAL_SAVE_THRESHOLD) {
+    return;
+  }
+
+#if defined(ARDUINO_ARCH_RP2040)
+  EEPROM.put(0, c);
+  EEPROM.commit();
+#endif
+  storedCal = c;
+  calStored = true;
+}
+
+// -------------------- NORMALIZED INPUT --------------------
+// Deadzone and shaping against the current calibration; no side effects,
+// so a replayed trace normalizes exactly as the live stick did
+static void normalizeAxes(int rawX, int rawY, float &nx, float &ny, int &rawDx, int &rawDy) {
   // Deadzone
   rawDx = applyDeadzone(rawX, joyCenterX, JOY_DEADZONE);
   rawDy = applyDeadzone(rawY, joyCenterY, JOY_DEADZONE);
@@ -76,13 +191,103 @@ void readNormalizedJoystick(float &nx, float &ny, int &rawDx, int &rawDy) {
   }
 }
 
-bool readButtonEdge() {
-  bool b = joyPressedRaw();
-  bool edge = (b && !btnPrev);
-  btnPrev = b;
-  return edge;
+void readNormalizedJoystick(float &nx, float &ny, int &rawDx, int &rawDy) {
+  adcStreamRead(joyAxes);
+  int rawX = joyAxes.x;
+  int rawY = joyAxes.y;
+  refineCalibration(rawX, rawY);
+
+  // Update observed extremes for Y (helps asymmetry)
+  if (rawY < joyMinY) joyMinY = rawY;
+  if (rawY > joyMaxY) joyMaxY = rawY;
+
+  normalizeAxes(rawX, rawY, nx, ny, rawDx, rawDy);
+}
+
+// -------------------- BUTTON INTERRUPT --------------------
+// Lockout debounce: the first edge that changes the state is taken and
+// anything within BUTTON_DEBOUNCE_US after it is contact bounce.
+static void onButtonChange() {
+  uint32_t nowUs = micros();
+  bool pressed = joyPressedRaw();
+  if (pressed == btnState) return;
+  if ((uint32_t)(nowUs - btnLastEdgeUs) < BUTTON_DEBOUNCE_US) return;
+
+  btnState = pressed;
+  btnLastEdgeUs = nowUs;
+  ButtonEvent ev = {nowUs, (uint8_t)(pressed ? 1 : 0)};
+  buttonQueue.push(ev);
+}
+
+void buttonBegin() {
+  btnState = joyPressedRaw();
+  btnLastEdgeUs = micros();
+  attachInterrupt(digitalPinToInterrupt(PIN_JOY_SW), onButtonChange, CHANGE);
+}
+
+bool buttonPollEvent(ButtonEvent &ev) {
+  if (buttonQueue.pop(ev)) return true;
+
+  // A final edge swallowed by the lockout has no later edge to report it;
+  // settle against the pin once the window has passed
+  bool level = joyPressedRaw();
+  uint32_t nowUs = micros();
+  noInterrupts();
+  bool missed = (level != btnState) && (uint32_t)(nowUs - btnLastEdgeUs) >= BUTTON_DEBOUNCE_US;
+  if (missed) {
+    btnState = level;
+    btnLastEdgeUs = nowUs;
+  }
+  interrupts();
+
+  if (!missed) return false;
+  ev.us = nowUs;
+  ev.pressed = level ? 1 : 0;
+  return true;
+}
+
+// -------------------- INPUT TASK --------------------
+// While a trace replays, the stick and button come from the trace instead
+void latchJoystick() {
+  if (traceReplaying()) return;
+  readNormalizedJoystick(joyLatest.nx, joyLatest.ny, joyLatest.rawDx, joyLatest.rawDy);
+  joyLatest.axisX = joyAxes.x;
+  joyLatest.axisY = joyAxes.y;
+  joyLatest.sampledUs = joyAxes.sampledUs;
+}
+
+// Latch filtered axes that did not come from the ADC stream (trace replay),
+// normalized against the calibration currently in effect
+void injectJoystick(int rawX, int rawY) {
+  normalizeAxes(rawX, rawY, joyLatest.nx, joyLatest.ny, joyLatest.rawDx, joyLatest.rawDy);
+  joyLatest.axisX = (int16_t)rawX;
+  joyLatest.axisY = (int16_t)rawY;
+  joyLatest.sampledUs = micros();
+}
+
+void sampleInput() {
+  if (traceReplaying()) return;
+  latchJoystick();
+
+  // Presses latch until the simulation consumes them, including ones made
+  // while it is not accepting clicks (unload), unless they go stale first
+  ButtonEvent ev;
+  while (buttonPollEvent(ev)) {
+    if (ev.pressed) {
+      clickPending = true;
+      clickPressUs = ev.us;
+    }
+  }
+  if (clickPending && (uint32_t)(micros() - clickPressUs) > BUTTON_PRESS_MAX_AGE_US) {
+    clickPending = false;
+  }
 }
 
-void resetButtonState() {
-  btnPrev = false;
+bool consumeClick() {
+  if (traceReplaying()) return traceReplayClick();
+  if (!clickPending) return false;
+  clickPending = false;
+  latencyRecord(clickToResponse, micros() - clickPressUs);
+  traceRecordClick();
+  return true;
 }
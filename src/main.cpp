@@ -3,12 +3,19 @@
 //
 // Domain modules:
 // - input.cpp    : Joystick and button handling
+// - adcstream.cpp: Free-running DMA joystick sampling and filtering
 // - bee.cpp      : Bee position, physics, wings, boost
-// - flowers.cpp  : Flower spawning, collection, targeting
+// - flowers.cpp  : Flower field streaming, collection, targeting
 // - hive.cpp     : Hive interaction, unloading, belt
 // - radar.cpp    : Radar ping and targeting
-// - vfx.cpp      : Trails, popups, camera, visual effects
+// - vfx.cpp      : Popups, camera, visual effects
+// - particles.cpp: SoA particle engine and emitters
+// - wasps.cpp    : Hard-mode wasp swarm (boids, sprites)
 // - survival.cpp : Timer, score, game over state
+// - timers.cpp   : Deadline wheel for effect and item expiries
+// - audio.cpp    : Synth on core1, fed by an event ring and motion mailbox
+// - trace.cpp    : Input trace record/replay with per-step state hashes
+// - scheduler.cpp: Cooperative multi-rate task dispatch
 // - graphics.cpp : All rendering
 
 #include "game.h"
@@ -21,10 +28,40 @@ uint32_t rngState = 0xA5A5F00Du;
 Adafruit_ST7789 tft(&SPI, PIN_CS, PIN_DC, PIN_RST);
 GFXcanvas16 canvas(CANVAS_W, CANVAS_H);
 
-// Global sound synthesizer
-BuzzSynth buzzer(PIN_BUZZ);
+// -------------------- SIMULATION CLOCK --------------------
+static uint32_t simNowMs = 0;     // Timestamp of the latest simulation step (millis domain)
+static uint32_t simAccumUs = 0;   // Wall time not yet simulated
+
+// -------------------- TASKS --------------------
+static const uint32_t INPUT_PERIOD_US = 2000;   // 500 Hz
+
+static int taskInput = -1;
+static int taskSim = -1;
+static int taskAudio = -1;
+static int taskRender = -1;
+
+// Stick latch -> frame pushed to the panel, for late-latched frames
+LatencyStats latchToPresent = {0, 0, 0, 0};
+
+// -------------------- BOOT PROFILE --------------------
+BootProfile bootProfile;
+static uint32_t bootMarkUs = 0;   // Phases are measured from reset
+
+static void bootMark(BootPhase phase) {
+  uint32_t nowUs = micros();
+  bootProfile.phaseUs[phase] = nowUs - bootMarkUs;
+  bootMarkUs = nowUs;
+}
+
+static void inputTask(uint32_t nowUs);
+static void simTask(uint32_t nowUs);
+static void audioTask(uint32_t nowUs);
+static void renderTask(uint32_t nowUs);
 
 // -------------------- SETUP --------------------
+// Ordered for time-to-first-frame: input hardware starts first so the ADC
+// stream has filled while the panel initializes, and the first frame is
+// drawn straight over the panel (every pixel is covered, so no clear).
 void setup() {
   // Backlight
   pinMode(PIN_BL, OUTPUT);
@@ -32,9 +69,22 @@ void setup() {
 
   // Joystick button
   pinMode(PIN_JOY_SW, INPUT_PULLUP);
+  buttonBegin();
+
+  // Audio (core1 brings up the synth itself)
+  audioBegin();
+
+  // Seed RNG
+  rngState ^= (uint32_t)analogRead(PIN_JOY_VRX) << 16;
+  rngState ^= (uint32_t)analogRead(PIN_JOY_VRY) << 1;
+  rngState ^= (uint32_t)micros();
 
-  // Audio
-  buzzer.begin();
+  // Input trace, if this build records or replays one
+  traceBegin();
+
+  // ADC free-runs from here on; analogRead must not be used after this
+  adcStreamBegin();
+  bootMark(BOOT_PHASE_HARDWARE);
 
   // SPI display
   SPI.setSCK(PIN_SCK);
@@ -43,46 +93,59 @@ void setup() {
 
   tft.init(240, 320);
   tft.setRotation(1);
+  bootMark(BOOT_PHASE_DISPLAY);
 
-  // Seed RNG
-  rngState ^= (uint32_t)analogRead(PIN_JOY_VRX) << 16;
-  rngState ^= (uint32_t)analogRead(PIN_JOY_VRY) << 1;
-  rngState ^= (uint32_t)micros();
-
-  tft.fillScreen(COL_BG0);
-
-  // Calibrate input
-  calibrateJoystick();
-  joyMinY = joyCenterY;
-  joyMaxY = joyCenterY;
+  // Calibrate input: stored values, or a seed refined during play
+  bootProfile.calibrationFromFlash = beginJoystickCalibration(millis());
+  bootMark(BOOT_PHASE_CALIBRATION);
 
-  // Initialize all domains
+  // Initialize all domains (a replayed trace restores the recorded seed and
+  // sim clock first)
+  simNowMs = millis();
+  traceBoot(simNowMs);
+  resetTimers(simNowMs);
   resetBee();
   resetHive();
   resetVFX();
+  resetParticles();
+  resetWasps();
   resetSurvival();
   resetRadar();
-  initFlowers();
-
-  renderFrame(millis());
+  bootMark(BOOT_PHASE_WORLD);
+
+  renderFrame(simNowMs);
+  bootMark(BOOT_PHASE_FIRST_FRAME);
+  bootProfile.firstFrameUs = bootMarkUs;
+
+  // Flowers fill in from the next frame on
+  initFlowers(simNowMs);
+  bootMark(BOOT_PHASE_FLOWERS);
+
+  // Most urgent first on equal deadlines
+  uint32_t nowUs = micros();
+  taskInput = schedulerAddTask("input", inputTask, INPUT_PERIOD_US, 0, nowUs);
+  taskAudio = schedulerAddTask("audio", audioTask, AUDIO_PERIOD_US, 1, nowUs);
+  taskSim = schedulerAddTask("sim", simTask, SIM_STEP_US, 2, nowUs);
+  taskRender = schedulerAddTask("render", renderTask, RENDER_INTERVAL_ACTIVE_MS * 1000u, 3, nowUs);
 }
 
-// -------------------- LOOP --------------------
-void loop() {
-  static uint32_t lastMs = millis();
-  uint32_t now = millis();
-  uint32_t dtMs = now - lastMs;
-  if (dtMs > MAX_DELTA_MS) dtMs = MAX_DELTA_MS;
-  lastMs = now;
-  float dt = (float)dtMs / 1000.0f;
+// -------------------- SIMULATION STEP --------------------
+// Advances gameplay by exactly SIM_STEP_MS, independent of render cost.
+static void simulateStep(uint32_t now) {
+  const float dt = SIM_DT_SEC;
+  const fix16 dtFx = SIM_DT;
 
   static bool wasBoosting = false;
 
+  captureInterpolationState();
+
+  // Expiries due by this step (item lifetimes, radar, effect windows)
+  processTimers(now);
+  updateParticles();
+
   if (!isUnloading) {
-    // Read input
-    float nx, ny;
-    int rawDx, rawDy;
-    readNormalizedJoystick(nx, ny, rawDx, rawDy);
+    // Latest input from the input task
+    const JoystickSample &joy = joyLatest;
 
     // Check boost state
     bool boosting = isBoosting(now);
@@ -92,41 +155,39 @@ void loop() {
     wasBoosting = boosting;
 
     // Update bee physics and animation
-    updateBeePhysics(nx, ny, rawDx, rawDy, dt, boosting);
+    updateBeePhysics(joy.nx, joy.ny, joy.rawDx, joy.rawDy, dtFx, boosting);
     updateWingAnimation(dt);
+    updateFlowerField(now);
 
     // Boost trail VFX
     if (boosting && wingSpeed > 0.2f) {
       static uint32_t lastTrailMs = 0;
       if ((uint32_t)(now - lastTrailMs) > TRAIL_SPAWN_INTERVAL_MS) {
-        float spN = clampf((fabsf(beeVX) + fabsf(beeVY)) / WING_SPEED_DIVISOR, 0.0f, 1.0f);
-        spawnTrailParticle(beeWX, beeWY, spN, now);
-        spawnTrailParticle(beeWX - beeVX * 0.02f, beeWY - beeVY * 0.02f, spN, now);
+        static const fix16 trailLag = fxFromFloat(0.02f);
+        uint8_t band = (uint8_t)(clampf(wingSpeed, 0.0f, 1.0f) * 3.0f + 0.5f);
+        emitParticles(EMIT_BOOST_TRAIL, beeWX, beeWY, 0, 0, band, 1);
+        emitParticles(EMIT_BOOST_TRAIL, beeWX - fxMul(beeVX, trailLag), beeWY - fxMul(beeVY, trailLag),
+                      0, 0, band, 1);
         lastTrailMs = now;
       }
     }
 
     // Update VFX
-    updateTrailParticles(now);
-    updateScorePopups(now);
-    updateCamera(dt, boosting, now);
+    updateCamera(dtFx, boosting, now);
 
   } else {
     // During unload: bee at hive, no movement
     wasBoosting = false;
     stopBeeMovement();
 
-    float zoomLerp = clampf(CAMERA_ZOOM_LERP_SPEED * dt, 0.0f, 1.0f);
-    cameraZoom += (1.0f - cameraZoom) * zoomLerp;
-    cameraShakeX = 0.0f;
-    cameraShakeY = 0.0f;
+    settleCamera(dtFx);
 
-    updateBeltLifetimes(now);
     updateUnload(now);
-    updateTrailParticles(now);
-    updateScorePopups(now);
   }
 
+  // Hazards keep flying while the bee unloads (the hive is off limits)
+  if (!isGameOver) updateWasps(dtFx, now);
+
   // Survival timer
   updateSurvivalTimer(dt, now);
 
@@ -134,78 +195,163 @@ void loop() {
   if (isGameOver) {
     static bool soundStopped = false;
     if (!soundStopped) {
-      buzzer.stopAll();
+      audioStopAll();
       isUnloading = false;
       unloadRemaining = 0;
       unloadTotal = 0;
       soundStopped = true;
+      // Static game-over screen hides the flash write stall
+      saveJoystickCalibration();
     }
     // Reset flag when game restarts
     if (survivalTimeLeft > 0.0f) soundStopped = false;
   }
 
-  // Button handling
-  bool edgeDown = false;
-  if (!isUnloading) {
-    edgeDown = readButtonEdge();
-  } else {
-    resetButtonState();
-  }
+  // Button handling (presses latched by the input task). Presses made
+  // during unload stay queued and act once it ends, if still fresh
+  bool edgeDown = (isGameOver || !isUnloading) && consumeClick();
 
   // Game over restart
   if (isGameOver && edgeDown) {
-    // Reset all domains
+    // Stick held up while pressing: hard mode (wasps)
+    waspsEnabled = joyLatest.ny < -0.5f;
+
+    // Reset all domains (pending expiries belong to the old round)
+    resetTimers(now);
     resetBee();
     resetHive();
     resetVFX();
+    resetParticles();
+    resetWasps();
     resetSurvival();
     resetRadar();
-    initFlowers();
+    initFlowers(now);
 
     // Reset sound state
-    SoundState& snd = buzzer.getState();
-    snd.prevVX = 0.0f;
-    snd.prevVY = 0.0f;
-    snd.heading = 0.0f;
-    snd.turnRateSmooth = 0.0f;
-    snd.accelSmooth = 0.0f;
-    snd.radialAccelSmooth = 0.0f;
-    snd.eventTailUntilMs = 0;
-    snd.ambientEnv = 0.0f;
-    snd.ambientFreqSmooth = 0.0f;
-    snd.lastUnloadFreq = 0.0f;
+    audioResetMotion();
   }
 
   // Normal game input
   if (!isGameOver && !isUnloading) {
     if (edgeDown) {
-      if (!buzzer.soundBusy()) buzzer.startSound(SND_CLICK, now);
+      audioPost(SND_CLICK);
       beginRadarPing(now);
     }
 
-    updateBeltLifetimes(now);
-    updateRadar(now);
     tryCollectPollen(now);
     tryStoreAtHive(now);
+  }
+}
 
-    // Ambient wing buzz
-    float speed = getBeeSpeed();
-    buzzer.updateAmbient(now, dt, wingSpeed, beeVX, beeVY, speed);
-    buzzer.updateSound(now);
+// -------------------- INPUT TASK --------------------
+static void inputTask(uint32_t nowUs) {
+  sampleInput();
+  if (bootProfile.firstInputUs == 0) bootProfile.firstInputUs = nowUs;
+}
+
+// -------------------- SIMULATION TASK --------------------
+static void simTask(uint32_t nowUs) {
+  static uint32_t lastUs = nowUs;
+  simAccumUs += nowUs - lastUs;
+  lastUs = nowUs;
+
+  // Long stall: drop the excess rather than fast-forwarding, but keep the
+  // sim clock on millis() so timers set from either side stay comparable
+  const uint32_t maxAccumUs = MAX_DELTA_MS * 1000u;
+  if (simAccumUs > maxAccumUs) {
+    uint32_t dropMs = (simAccumUs - maxAccumUs) / 1000u;
+    simNowMs += dropMs;
+    simAccumUs -= dropMs * 1000u;
+  }
+
+  while (simAccumUs >= SIM_STEP_US) {
+    simAccumUs -= SIM_STEP_US;
+    // Replays take the recorded step clock (and stalls) instead
+    simNowMs = traceStepBegin(simNowMs + SIM_STEP_MS);
+    simulateStep(simNowMs);
+    traceStepEnd();
   }
+}
 
-  // Render at adaptive cadence
-  static uint32_t lastRenderMs = 0;
-  uint32_t renderInterval = RENDER_INTERVAL_ACTIVE_MS;
-  bool boosting = isBoosting(now);
-  bool idle = !isGameOver && !isUnloading && !radarActive && !boosting
-              && (wingSpeed < 0.05f) && !anyTrailAlive() && !anyBeltAlive() && !anyScorePopupAlive();
-  if (idle) renderInterval = RENDER_INTERVAL_IDLE_MS;
-
-  if ((uint32_t)(now - lastRenderMs) >= renderInterval) {
-    lastRenderMs = now;
-    renderFrame(now);
+// -------------------- AUDIO TASK --------------------
+// Publishes bee motion for the synth on core1, which keeps its own clock
+static void audioTask(uint32_t nowUs) {
+  (void)nowUs;
+  AudioMotion m = {0, 0, 0, 0, false};
+  m.active = !isGameOver && !isUnloading;
+  if (m.active) {
+    // Velocity blended between sim steps so the 1 kHz turn/accel estimates
+    // see a smooth signal rather than a 250 Hz staircase
+    fix16 alpha = fxClamp(fxRatio((int32_t)simAccumUs, (int32_t)SIM_STEP_US), 0, FX_ONE);
+    interpolateBeeVelocity(alpha, m.vx, m.vy);
+    m.speed = fxHypot(m.vx, m.vy);
+    m.wingSpeed = fxFromFloat(wingSpeed);
   }
+  audioPublishMotion(m);
+}
+
+// -------------------- RENDER TASK --------------------
+static void renderTask(uint32_t nowUs) {
+  if (LATE_LATCH_ENABLED && !isGameOver && !isUnloading) {
+    // Fresh stick, then extrapolate from the latest sim state to when this
+    // frame should land: the unsimulated remainder plus the last measured
+    // latch-to-present time. The scheduler's dispatch time doubles as the
+    // latch timestamp; the stick is read straight after.
+    uint32_t latchUs = nowUs;
+    latchJoystick();
+
+    uint32_t leadUs = simAccumUs + latchToPresent.lastUs;
+    if (leadUs > LATE_LATCH_MAX_LEAD_MS * 1000u) leadUs = LATE_LATCH_MAX_LEAD_MS * 1000u;
+    fix16 lead = fxRatio((int32_t)leadUs, 1000000);
+
+    fix16 px, py;
+    predictBeePosition(joyLatest, lead, isBoosting(simNowMs), px, py);
+    updateCameraTransformAt(px, py, lead);
+    renderFrame(simNowMs + leadUs / 1000u);
+
+    latencyRecord(latchToPresent, micros() - latchUs);
+  } else {
+    // Draw between the last two sim states; the frame shows the moment
+    // alpha of the way through the step that is still accumulating
+    fix16 alpha = fxRatio((int32_t)simAccumUs, (int32_t)SIM_STEP_US);
+    updateCameraTransform(alpha);
+    renderFrame(simNowMs - SIM_STEP_MS + simAccumUs / 1000u);
+  }
+
+  // Adaptive cadence for the next frame: pending boost, radar, shake,
+  // flash and item lifetimes all hold a keep-awake timer
+  bool quiet = !isGameOver && !isUnloading && (wingSpeed < 0.05f);
+  bool idle = quiet && !timersKeepAwake() && particleCount() == 0 && waspCount() == 0;
+  uint32_t intervalMs = idle ? RENDER_INTERVAL_IDLE_MS : RENDER_INTERVAL_ACTIVE_MS;
+
+  // Bee at rest with only effects winding down: land a frame just after the
+  // next expiry so a vanishing overlay is not left up for a whole interval
+  uint32_t nextMs;
+  if (quiet && timerNextDeadline(simNowMs, nextMs)) {
+    int32_t untilMs = (int32_t)(nextMs - simNowMs) + SIM_STEP_MS;
+    if (untilMs > 0 && (uint32_t)untilMs < intervalMs) intervalMs = (uint32_t)untilMs;
+  }
+  schedulerSetPeriod(taskRender, intervalMs * 1000u);
+
+  // Spare time: a little of the next round's flower layout
+  if (idle || isGameOver) prepareFlowerSites();
+  traceFlush();
+}
+
+// -------------------- LOOP --------------------
+// Runs the most urgent due task, or sleeps until the next release.
+void loop() {
+  schedulerRunOnce();
+}
+
+#if defined(ARDUINO_ARCH_RP2040)
+// -------------------- CORE1 --------------------
+// The synth only: audio events and bee motion arrive from core0.
+void setup1() {
+  audioCoreSetup();
+}
 
-  delay(LOOP_DELAY_MS);
+void loop1() {
+  audioCoreLoop();
 }
+#endif
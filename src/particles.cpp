@@ -0,0 +1,242 @@
+// Pixel Buzz Box - Particles (SoA Engine and Emitters)
+#include "game.h"
+#include <math.h>
+
+// -------------------- PARTICLE STORAGE --------------------
+// Struct-of-arrays: the update pass streams through positions, velocities
+// and ages only; colour and shape are looked up from a per-emitter ramp.
+// Live particles are packed into [0, particleLive) and culled by swapping
+// the last one into the hole.
+static fix16 partX[PARTICLE_MAX], partY[PARTICLE_MAX];       // World position
+static fix16 partVX[PARTICLE_MAX], partVY[PARTICLE_MAX];     // World units/s
+static uint16_t partAgeMs[PARTICLE_MAX];
+static uint16_t partLifeMs[PARTICLE_MAX];
+static uint16_t partRampPos[PARTICLE_MAX];    // Ramp index, 8 fractional bits
+static uint16_t partRampStep[PARTICLE_MAX];   // Ramp advance per sim step
+static uint8_t partRamp[PARTICLE_MAX];
+static uint8_t partKind[PARTICLE_MAX];
+static uint8_t partFlags[PARTICLE_MAX];
+static int16_t partSX[PARTICLE_MAX], partSY[PARTICLE_MAX];   // Screen position, per frame
+static int particleLive = 0;
+
+static const uint8_t PART_SPARKLE = 0x01;     // Cross of bright pixels while young
+
+// -------------------- COLOUR RAMPS --------------------
+// Each ramp is the full life of one particle look, sampled at RAMP_STEPS
+// points: glow colours plus the shape to draw at that age.
+static const int RAMP_STEPS = 16;
+
+enum RampShape : uint8_t {
+  SHAPE_PIXEL = 0,      // Single pixel
+  SHAPE_DOT,            // Mid glow r3 + core r1
+  SHAPE_GLOW,           // Outer r5 + mid r3 + core r2
+  SHAPE_SPECK           // Core r1 only
+};
+
+struct RampStep {
+  uint16_t core, mid, outer;
+  uint8_t shape;
+};
+
+enum RampId : uint8_t {
+  RAMP_TRAIL_0 = 0,     // Boost trail, four speed bands (warm -> cool)
+  RAMP_TRAIL_3 = 3,
+  RAMP_POLLEN,
+  RAMP_BLOOM,
+  RAMP_DEBRIS,
+  RAMP_N
+};
+
+static RampStep ramps[RAMP_N][RAMP_STEPS];
+static bool rampsBuilt = false;
+
+static void buildRamp(RampStep *ramp, uint8_t r0, uint8_t g0, uint8_t b0,
+                      uint8_t r1, uint8_t g1, uint8_t b1, uint8_t bigShape, uint8_t smallShape) {
+  for (int s = 0; s < RAMP_STEPS; s++) {
+    float t = (float)s / (float)(RAMP_STEPS - 1);
+    float alpha = 1.0f - t * t;
+    uint8_t r = (uint8_t)((r0 + (r1 - r0) * t) * alpha);
+    uint8_t g = (uint8_t)((g0 + (g1 - g0) * t) * alpha);
+    uint8_t b = (uint8_t)((b0 + (b1 - b0) * t) * alpha);
+    ramp[s].core = rgb565(r, g, b);
+    ramp[s].mid = rgb565(r / 2, g / 2, b / 2);
+    ramp[s].outer = rgb565(r / 3, g / 3, b / 3);
+    ramp[s].shape = (alpha > 0.6f) ? bigShape : (alpha > 0.3f) ? smallShape : (uint8_t)SHAPE_PIXEL;
+  }
+}
+
+static void buildRamps() {
+  for (int band = 0; band <= RAMP_TRAIL_3 - RAMP_TRAIL_0; band++) {
+    float speedT = (float)band / (float)(RAMP_TRAIL_3 - RAMP_TRAIL_0);
+    uint8_t r = (uint8_t)(255 - (int)(115.0f * speedT));
+    uint8_t g = (uint8_t)(220 - (int)(120.0f * speedT));
+    uint8_t b = (uint8_t)(60 + (int)(195.0f * speedT));
+    buildRamp(ramps[RAMP_TRAIL_0 + band], r, g, b, r, g, b, SHAPE_GLOW, SHAPE_DOT);
+  }
+  buildRamp(ramps[RAMP_POLLEN], 255, 255, 210, 255, 220, 40, SHAPE_SPECK, SHAPE_PIXEL);
+  buildRamp(ramps[RAMP_BLOOM], 255, 240, 250, 255, 120, 180, SHAPE_DOT, SHAPE_SPECK);
+  buildRamp(ramps[RAMP_DEBRIS], 220, 255, 230, 90, 140, 90, SHAPE_SPECK, SHAPE_PIXEL);
+  rampsBuilt = true;
+}
+
+// -------------------- EMITTERS --------------------
+struct EmitterDef {
+  uint16_t lifeMinMs, lifeMaxMs;
+  int16_t speedMin, speedMax;     // World units/s, random direction
+  int16_t gravity;                // World units/s^2 (+y is down the screen)
+  float drag;                     // Velocity decay per second
+  uint8_t ramp;                   // First ramp; variants add to it
+  uint8_t sparkleOneIn;           // 1 in N particles sparkle (0 = never)
+};
+
+static const EmitterDef EMITTERS[EMITTER_N] = {
+  // lifeMin, lifeMax, speedMin, speedMax, gravity, drag, ramp, sparkle
+  { TRAIL_LIFE_MS, TRAIL_LIFE_MS, 0, 0, 0, 0.0f, RAMP_TRAIL_0, 3 },   // EMIT_BOOST_TRAIL
+  { 260, 480, 30, 90, 0, 4.0f, RAMP_POLLEN, 4 },                     // EMIT_POLLEN_SPARKLE
+  { 300, 600, 20, 60, 0, 3.0f, RAMP_BLOOM, 0 },                      // EMIT_BLOOM_SPARK
+  { 350, 650, 40, 110, 160, 2.0f, RAMP_DEBRIS, 0 },                  // EMIT_HIVE_DEBRIS
+};
+
+// Per-step velocity multipliers, exp(-drag * dt), fixed at first use
+static fix16 dragStep[EMITTER_N];
+
+// -------------------- LIFECYCLE --------------------
+void resetParticles() {
+  if (!rampsBuilt) {
+    buildRamps();
+    for (int k = 0; k < EMITTER_N; k++) dragStep[k] = fxFromFloat(expf(-EMITTERS[k].drag * SIM_DT_SEC));
+  }
+  particleLive = 0;
+}
+
+int particleCount() {
+  return particleLive;
+}
+
+void emitParticles(EmitterKind kind, fix16 wx, fix16 wy, fix16 vx, fix16 vy, uint8_t variant, int count) {
+  if (!rampsBuilt) resetParticles();
+  const EmitterDef &e = EMITTERS[kind];
+
+  for (int n = 0; n < count; n++) {
+    int i;
+    if (particleLive < PARTICLE_MAX) {
+      i = particleLive++;
+    } else {
+      // Full: recycle a slot rather than drop the newest effect
+      i = (int)(xrnd() % PARTICLE_MAX);
+    }
+
+    uint16_t life = e.lifeMinMs;
+    if (e.lifeMaxMs > e.lifeMinMs) life = (uint16_t)irand(e.lifeMinMs, e.lifeMaxMs);
+
+    fix16 pvx = vx, pvy = vy;
+    if (e.speedMax > 0) {
+      angle16 dir = (angle16)xrnd();
+      int32_t speed = irand(e.speedMin, e.speedMax);
+      pvx += fxFromInt(isinScaled((angle16)(dir + ANGLE_QUARTER), speed));
+      pvy += fxFromInt(isinScaled(dir, speed));
+    }
+
+    partX[i] = wx;
+    partY[i] = wy;
+    partVX[i] = pvx;
+    partVY[i] = pvy;
+    partAgeMs[i] = 0;
+    partLifeMs[i] = life;
+    partRamp[i] = (uint8_t)(e.ramp + variant);
+    partKind[i] = (uint8_t)kind;
+    partRampPos[i] = 0;
+    partRampStep[i] = (uint16_t)(((uint32_t)(RAMP_STEPS - 1) * 256u * SIM_STEP_MS) / life);
+    partFlags[i] = (e.sparkleOneIn && (xrnd() % e.sparkleOneIn) == 0) ? PART_SPARKLE : 0;
+  }
+}
+
+// -------------------- UPDATE --------------------
+// One fused pass per sim step: age, cull, integrate.
+void updateParticles() {
+  int i = 0;
+  while (i < particleLive) {
+    uint16_t age = (uint16_t)(partAgeMs[i] + SIM_STEP_MS);
+    if (age >= partLifeMs[i]) {
+      int last = --particleLive;
+      partX[i] = partX[last];
+      partY[i] = partY[last];
+      partVX[i] = partVX[last];
+      partVY[i] = partVY[last];
+      partAgeMs[i] = partAgeMs[last];
+      partLifeMs[i] = partLifeMs[last];
+      partRampPos[i] = partRampPos[last];
+      partRampStep[i] = partRampStep[last];
+      partRamp[i] = partRamp[last];
+      partKind[i] = partKind[last];
+      partFlags[i] = partFlags[last];
+      continue;   // Slot i now holds an unprocessed particle
+    }
+    partAgeMs[i] = age;
+    partRampPos[i] = (uint16_t)(partRampPos[i] + partRampStep[i]);
+
+    const EmitterDef &e = EMITTERS[partKind[i]];
+    if (e.speedMax > 0) {
+      partVX[i] = fxMul(partVX[i], dragStep[partKind[i]]);
+      partVY[i] = fxMul(partVY[i], dragStep[partKind[i]]) + e.gravity * (int32_t)(SIM_DT);
+    }
+    partX[i] += fxMul(partVX[i], SIM_DT);
+    partY[i] += fxMul(partVY[i], SIM_DT);
+    i++;
+  }
+}
+
+// -------------------- RENDER --------------------
+// Screen positions once per frame; each tile then only offsets and culls.
+// Each particle is moved along its velocity from the latest sim step to
+// the frame's time, like the camera: back into the step for interpolated
+// frames, forward for late-latched ones.
+void projectParticles() {
+  for (int i = 0; i < particleLive; i++) {
+    int sx, sy;
+    worldToScreenFx(partX[i] + fxMul(partVX[i], cam.aheadSec), partY[i] + fxMul(partVY[i], cam.aheadSec), sx, sy);
+    partSX[i] = (int16_t)clampi(sx, -1000, 1000);
+    partSY[i] = (int16_t)clampi(sy, -1000, 1000);
+  }
+}
+
+void drawParticles(Adafruit_GFX &g, int ox, int oy) {
+  for (int i = 0; i < particleLive; i++) {
+    int x = partSX[i] + ox;
+    int y = partSY[i] + oy;
+    if (x < -6 || x > CANVAS_W + 6 || y < -6 || y > CANVAS_H + 6) continue;
+
+    int step = partRampPos[i] >> 8;
+    if (step >= RAMP_STEPS) step = RAMP_STEPS - 1;
+    const RampStep &rs = ramps[partRamp[i]][step];
+
+    switch (rs.shape) {
+      case SHAPE_GLOW:
+        g.fillCircle(x, y, 5, rs.outer);
+        g.fillCircle(x, y, 3, rs.mid);
+        g.fillCircle(x, y, 2, rs.core);
+        if ((partFlags[i] & PART_SPARKLE) && step < (RAMP_STEPS * 7) / 16) {
+          uint16_t sparkle = rgb565(255, 255, 200);
+          g.drawPixel(x - 3, y, sparkle);
+          g.drawPixel(x + 3, y, sparkle);
+          g.drawPixel(x, y - 3, sparkle);
+          g.drawPixel(x, y + 3, sparkle);
+        }
+        break;
+      case SHAPE_DOT:
+        g.fillCircle(x, y, 3, rs.mid);
+        g.fillCircle(x, y, 1, rs.core);
+        break;
+      case SHAPE_SPECK:
+        g.fillCircle(x, y, 1, rs.core);
+        if ((partFlags[i] & PART_SPARKLE) && step < RAMP_STEPS / 2) {
+          g.drawPixel(x - 2, y, COL_WHITE);
+          g.drawPixel(x + 2, y, COL_WHITE);
+        }
+        break;
+      default:
+        g.drawPixel(x, y, rs.core);
+        break;
+    }
+  }
+}
@@ -2,8 +2,6 @@
 #include "game.h"
 #include "BuzzSynth.h"
 
-extern BuzzSynth buzzer;
-
 // -------------------- RADAR STATE --------------------
 bool radarActive = false;
 uint32_t radarUntilMs = 0;
@@ -12,9 +10,14 @@ int32_t radarTargetWY = 0;
 bool radarToHive = false;
 
 // -------------------- RADAR PING --------------------
+static void endRadarPing(uint16_t) {
+  radarActive = false;
+}
+
 void beginRadarPing(uint32_t nowMs) {
   radarActive = true;
   radarUntilMs = nowMs + RADAR_DURATION_MS;
+  timerArm(TIMER_RADAR, 0, radarUntilMs, endRadarPing, true);
 
   if (pollenCount > 0) {
     // Point to hive when carrying pollen
@@ -36,15 +39,7 @@ void beginRadarPing(uint32_t nowMs) {
     }
   }
 
-  if (!buzzer.soundBusy()) buzzer.startSound(SND_RADAR, nowMs);
-}
-
-// -------------------- RADAR UPDATE --------------------
-void updateRadar(uint32_t nowMs) {
-  if (!radarActive) return;
-  if ((int32_t)(nowMs - radarUntilMs) >= 0) {
-    radarActive = false;
-  }
+  audioPost(SND_RADAR);
 }
 
 // -------------------- RESET --------------------
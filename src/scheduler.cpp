@@ -0,0 +1,111 @@
+// Pixel Buzz Box - Scheduler (Cooperative Multi-Rate Tasks)
+#include "game.h"
+
+// -------------------- TASK TABLE --------------------
+// Each task is released once per period and must finish before its next
+// release (its deadline). Among released tasks the earliest deadline runs
+// first; priority breaks ties (lower value = more urgent).
+struct SchedTask {
+  const char *name;
+  TaskFn fn;
+  uint32_t periodUs;
+  uint32_t releaseUs;
+  uint8_t priority;
+  TaskStats stats;
+};
+
+static SchedTask tasks[SCHED_MAX_TASKS];
+static int taskCount = 0;
+
+static inline uint32_t deadlineOf(const SchedTask &t) {
+  return t.releaseUs + t.periodUs;
+}
+
+// -------------------- REGISTRATION --------------------
+int schedulerAddTask(const char *name, TaskFn fn, uint32_t periodUs, uint8_t priority,
+                     uint32_t nowUs) {
+  if (taskCount >= SCHED_MAX_TASKS) return -1;
+  SchedTask &t = tasks[taskCount];
+  t.name = name;
+  t.fn = fn;
+  t.periodUs = periodUs;
+  t.releaseUs = nowUs;
+  t.priority = priority;
+  memset(&t.stats, 0, sizeof(t.stats));
+  return taskCount++;
+}
+
+void schedulerSetPeriod(int id, uint32_t periodUs) {
+  if (id < 0 || id >= taskCount) return;
+  tasks[id].periodUs = periodUs;
+}
+
+// -------------------- DISPATCH --------------------
+void schedulerRunOnce() {
+  uint32_t nowUs = micros();
+
+  int best = -1;
+  for (int i = 0; i < taskCount; i++) {
+    const SchedTask &t = tasks[i];
+    if ((int32_t)(nowUs - t.releaseUs) < 0) continue;
+    if (best < 0) { best = i; continue; }
+    int32_t d = (int32_t)(deadlineOf(t) - deadlineOf(tasks[best]));
+    if (d < 0 || (d == 0 && t.priority < tasks[best].priority)) best = i;
+  }
+
+  if (best < 0) {
+    // Nothing due: sleep until the next release
+    int32_t waitUs = INT32_MAX;
+    for (int i = 0; i < taskCount; i++) {
+      int32_t w = (int32_t)(tasks[i].releaseUs - nowUs);
+      if (w < waitUs) waitUs = w;
+    }
+    if (waitUs > 0 && waitUs != INT32_MAX) delayMicroseconds((uint32_t)waitUs);
+    return;
+  }
+
+  SchedTask &t = tasks[best];
+  uint32_t latencyUs = nowUs - t.releaseUs;
+  if (latencyUs > t.stats.worstLatencyUs) t.stats.worstLatencyUs = latencyUs;
+  if ((int32_t)(nowUs - deadlineOf(t)) > 0) t.stats.overruns++;
+
+  t.fn(nowUs);
+
+  uint32_t endUs = micros();
+  uint32_t runUs = endUs - nowUs;
+  if (runUs > t.stats.worstRunUs) t.stats.worstRunUs = runUs;
+  t.stats.runs++;
+
+  // Next release; if a whole period is already missed, drop the backlog
+  t.releaseUs += t.periodUs;
+  if ((int32_t)(endUs - t.releaseUs) >= (int32_t)t.periodUs) t.releaseUs = endUs;
+}
+
+// -------------------- STATS --------------------
+int schedulerTaskCount() {
+  return taskCount;
+}
+
+const char *schedulerTaskName(int id) {
+  return (id >= 0 && id < taskCount) ? tasks[id].name : "";
+}
+
+const TaskStats &schedulerStats(int id) {
+  static const TaskStats empty = {0, 0, 0, 0};
+  return (id >= 0 && id < taskCount) ? tasks[id].stats : empty;
+}
+
+void latencyRecord(LatencyStats &s, uint32_t us) {
+  if (s.totalUs > 0xFFFFFFFFu - us) {
+    s.count = 0;
+    s.totalUs = 0;
+  }
+  s.count++;
+  s.lastUs = us;
+  s.totalUs += us;
+  if (us > s.worstUs) s.worstUs = us;
+}
+
+void schedulerResetStats() {
+  for (int i = 0; i < taskCount; i++) memset(&tasks[i].stats, 0, sizeof(tasks[i].stats));
+}
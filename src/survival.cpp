@@ -37,6 +37,7 @@ void addSurvivalTime(uint32_t nowMs, float amount) {
   survivalFlashStartPct = clampf(before / SURVIVAL_TIME_MAX, 0.0f, 1.0f);
   survivalFlashEndPct = clampf(after / SURVIVAL_TIME_MAX, 0.0f, 1.0f);
   survivalFlashUntilMs = nowMs + SURVIVAL_FLASH_MS;
+  timerArm(TIMER_SURVIVAL_FLASH, 0, survivalFlashUntilMs, nullptr, true);
 }
 
 // -------------------- RESET --------------------
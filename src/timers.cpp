@@ -0,0 +1,188 @@
+// Pixel Buzz Box - Timers (Deadline Wheel)
+#include "game.h"
+
+// -------------------- WHEEL LAYOUT --------------------
+// Hashed timing wheel: a timer lives in the slot of its deadline tick, so
+// processing only walks slots whose ticks have elapsed. Deadlines further
+// than one revolution out share a slot and simply wait for a later pass.
+static const int TIMER_MAX = 64;
+static const int WHEEL_SLOTS = 32;                 // Power of two
+static const uint32_t WHEEL_TICK_MS = 16;          // 512 ms per revolution
+static const uint8_t TIMER_NIL = 0xFF;
+static const uint8_t DUE_SLOT = WHEEL_SLOTS;      // Pseudo-slot: the due list of a pass
+
+struct TimerEntry {
+  uint32_t atMs;
+  TimerFn fn;
+  uint16_t arg;
+  uint8_t tag;
+  uint8_t slot;
+  uint8_t prev, next;     // Slot list (or free list via next)
+  uint8_t used;
+  uint8_t keepsAwake;
+};
+
+static TimerEntry timers[TIMER_MAX];
+static uint8_t wheel[WHEEL_SLOTS];
+static uint8_t dueHead = TIMER_NIL, dueTail = TIMER_NIL;   // Expired, not yet fired
+static uint8_t freeHead = TIMER_NIL;
+static uint32_t wheelTick = 0;        // Last tick processed
+static uint32_t passNowMs = 0;        // Time of the latest expiry pass
+static uint8_t keepAwakeCount = 0;
+static bool timersReady = false;
+
+// -------------------- LIST HELPERS --------------------
+static uint8_t &listHead(uint8_t slot) {
+  return slot == DUE_SLOT ? dueHead : wheel[slot];
+}
+
+static void unlinkTimer(uint8_t i) {
+  TimerEntry &t = timers[i];
+  if (t.prev != TIMER_NIL) timers[t.prev].next = t.next;
+  else listHead(t.slot) = t.next;
+  if (t.next != TIMER_NIL) timers[t.next].prev = t.prev;
+  else if (t.slot == DUE_SLOT) dueTail = t.prev;
+}
+
+static void releaseTimer(uint8_t i) {
+  TimerEntry &t = timers[i];
+  unlinkTimer(i);
+  if (t.keepsAwake) keepAwakeCount--;
+  t.used = 0;
+  t.next = freeHead;
+  freeHead = i;
+}
+
+static void linkTimer(uint8_t i) {
+  TimerEntry &t = timers[i];
+  uint32_t tick = t.atMs / WHEEL_TICK_MS;
+  // Already-due deadlines go in the current slot so the next pass sees them
+  if ((int32_t)(tick - wheelTick) < 0) tick = wheelTick;
+  t.slot = (uint8_t)(tick & (WHEEL_SLOTS - 1));
+  t.prev = TIMER_NIL;
+  t.next = wheel[t.slot];
+  if (t.next != TIMER_NIL) timers[t.next].prev = i;
+  wheel[t.slot] = i;
+}
+
+// Appended, so due timers fire in the order the pass found them
+static void linkDue(uint8_t i) {
+  TimerEntry &t = timers[i];
+  t.slot = DUE_SLOT;
+  t.prev = dueTail;
+  t.next = TIMER_NIL;
+  if (dueTail != TIMER_NIL) timers[dueTail].next = i;
+  else dueHead = i;
+  dueTail = i;
+}
+
+static uint8_t findTimer(TimerTag tag, uint16_t arg) {
+  for (int i = 0; i < TIMER_MAX; i++) {
+    if (timers[i].used && timers[i].tag == tag && timers[i].arg == arg) return (uint8_t)i;
+  }
+  return TIMER_NIL;
+}
+
+// -------------------- API --------------------
+// Starts the wheel at nowMs (the sim clock), not at millis(), so a replayed
+// session lays its deadlines out the same way
+void resetTimers(uint32_t nowMs) {
+  for (int i = 0; i < WHEEL_SLOTS; i++) wheel[i] = TIMER_NIL;
+  dueHead = dueTail = TIMER_NIL;
+  for (int i = 0; i < TIMER_MAX; i++) {
+    timers[i].used = 0;
+    timers[i].next = (i + 1 < TIMER_MAX) ? (uint8_t)(i + 1) : TIMER_NIL;
+  }
+  freeHead = 0;
+  keepAwakeCount = 0;
+  wheelTick = nowMs / WHEEL_TICK_MS;
+  passNowMs = nowMs;
+  timersReady = true;
+}
+
+void timerArm(TimerTag tag, uint16_t arg, uint32_t atMs, TimerFn fn, bool keepsAwake) {
+  if (!timersReady) resetTimers(atMs);
+
+  // One timer per (tag, arg): re-arming moves the deadline
+  uint8_t i = findTimer(tag, arg);
+  if (i != TIMER_NIL) {
+    releaseTimer(i);
+  }
+  if (freeHead == TIMER_NIL) return;
+
+  i = freeHead;
+  freeHead = timers[i].next;
+
+  TimerEntry &t = timers[i];
+  t.atMs = atMs;
+  t.fn = fn;
+  t.arg = arg;
+  t.tag = (uint8_t)tag;
+  t.used = 1;
+  t.keepsAwake = keepsAwake ? 1 : 0;
+  if (keepsAwake) keepAwakeCount++;
+  linkTimer(i);
+}
+
+void timerCancel(TimerTag tag, uint16_t arg) {
+  if (!timersReady) return;
+  uint8_t i = findTimer(tag, arg);
+  if (i != TIMER_NIL) releaseTimer(i);
+}
+
+void processTimers(uint32_t nowMs) {
+  if (!timersReady) resetTimers(nowMs);
+
+  passNowMs = nowMs;
+  uint32_t nowTick = nowMs / WHEEL_TICK_MS;
+  uint32_t ticks = nowTick - wheelTick + 1;
+  if (ticks > (uint32_t)WHEEL_SLOTS) ticks = WHEEL_SLOTS;
+
+  // Collect first, then fire: a callback may cancel or re-arm any timer,
+  // so no list walk may hold a link across one. Due timers wait on their
+  // own list, where a cancel or re-arm still finds (and drops) them.
+  for (uint32_t k = 0; k < ticks; k++) {
+    uint8_t slot = (uint8_t)((nowTick - k) & (WHEEL_SLOTS - 1));
+    uint8_t i = wheel[slot];
+    while (i != TIMER_NIL) {
+      uint8_t next = timers[i].next;
+      if ((int32_t)(nowMs - timers[i].atMs) >= 0) {
+        unlinkTimer(i);
+        linkDue(i);
+      }
+      i = next;
+    }
+  }
+  // The current slot stays live; later deadlines in it fire on a later pass.
+  // Re-arms from the callbacks below land after this pass's ticks.
+  wheelTick = nowTick;
+
+  while (dueHead != TIMER_NIL) {
+    uint8_t i = dueHead;
+    TimerFn fn = timers[i].fn;
+    uint16_t arg = timers[i].arg;
+    releaseTimer(i);
+    if (fn) fn(arg);
+  }
+}
+
+// The pass in progress, for callbacks that re-arm relative to their expiry
+uint32_t timerNowMs() {
+  return passNowMs;
+}
+
+bool timerNextDeadline(uint32_t nowMs, uint32_t &atMs) {
+  bool found = false;
+  int32_t best = 0;
+  for (int i = 0; i < TIMER_MAX; i++) {
+    if (!timers[i].used) continue;
+    int32_t d = (int32_t)(timers[i].atMs - nowMs);
+    if (!found || d < best) { best = d; found = true; }
+  }
+  if (found) atMs = nowMs + (uint32_t)best;
+  return found;
+}
+
+bool timersKeepAwake() {
+  return keepAwakeCount > 0;
+}
@@ -0,0 +1,309 @@
+// Pixel Buzz Box - Trace (Input Record/Replay, State Hashes)
+#include "game.h"
+
+#if defined(ARDUINO_ARCH_RP2040)
+#if __has_include("trace_data.h")
+#include "trace_data.h"   // From a recorded trace; see README (Host Tools)
+#else
+static const unsigned char traceReplayData[1] = {0};
+static const unsigned int traceReplayData_len = 0;
+#endif
+#endif
+
+// -------------------- FORMAT --------------------
+// Little-endian throughout. Header (16 bytes):
+//   u32 magic, u16 step ms, u16 reserved, u32 rngState, u32 boot sim clock
+// Then one record per simulation step:
+//   u8 flags, [varint dt ms], [u24 axes: x | y << 12], [4 x u16 calibration],
+//   u16 state hash (after the step)
+// Unchanged stick and calibration are left out, so a steady step is 3 bytes.
+static const uint8_t TICK_CLICK = 0x01;   // The step consumed a click
+static const uint8_t TICK_AXES = 0x02;    // Filtered stick axes changed
+static const uint8_t TICK_CAL = 0x04;     // Center or Y extremes changed
+static const uint8_t TICK_DT = 0x08;      // Step clock advanced by other than SIM_STEP_MS
+
+static const uint32_t HEADER_BYTES = 16;
+static const uint32_t TICK_MAX_BYTES = 1 + 5 + 3 + 8 + 2;
+
+// -------------------- TRACE STATE --------------------
+static TraceStatus status = {TRACE_OFF, false, false, 0, 0, 0, 0};
+static uint32_t stepMs = 0;              // Sim clock of the step in progress
+static uint32_t lastMs = 0;              // ... and of the previous one
+static int16_t lastAxisX, lastAxisY;
+static int16_t lastCal[4];
+static bool haveLast = false;
+
+// Record
+static TraceSink sink = nullptr;
+static uint8_t buf[TRACE_BUF_N];
+static uint32_t bufLen = 0;
+static bool stepClick = false;
+
+// Replay
+static const uint8_t *src = nullptr;
+static uint32_t srcLen = 0;
+static uint32_t srcPos = 0;
+static uint32_t bootRng = 0, bootMs = 0;
+static uint16_t expectHash = 0;
+static bool stepReplayed = false;
+
+// -------------------- STATE HASH --------------------
+static uint32_t floatBits(float f) {
+  uint32_t u;
+  memcpy(&u, &f, sizeof(u));
+  return u;
+}
+
+// Everything a diverged session would show within a step or two: the RNG
+// stream, the bee, and the counters and flags the rules act on
+uint32_t traceStateHash() {
+  uint32_t h = hash32(rngState);
+  h = hash32(h ^ (uint32_t)beeWX);
+  h = hash32(h ^ (uint32_t)beeWY);
+  h = hash32(h ^ (uint32_t)beeVX);
+  h = hash32(h ^ (uint32_t)beeVY);
+  h = hash32(h ^ floatBits(wingSpeed));
+  h = hash32(h ^ floatBits(survivalTimeLeft));
+  h = hash32(h ^ ((uint32_t)score << 16) ^ ((uint32_t)pollenCount << 8) ^ boostCharge);
+  h = hash32(h ^ ((uint32_t)unloadRemaining << 8)
+               ^ (isUnloading ? 1u : 0u) ^ (isGameOver ? 2u : 0u)
+               ^ (waspsEnabled ? 4u : 0u) ^ (radarActive ? 8u : 0u));
+  h = hash32(h ^ boostActiveUntilMs);
+  h = hash32(h ^ ((uint32_t)flowers.count() << 16) ^ (uint32_t)waspCount());
+  return hash32(h ^ (uint32_t)particleCount());
+}
+
+static uint16_t foldHash(uint32_t h) {
+  return (uint16_t)(h ^ (h >> 16));
+}
+
+// -------------------- BYTE HELPERS --------------------
+static uint8_t *putU16(uint8_t *p, uint32_t v) {
+  p[0] = (uint8_t)v;
+  p[1] = (uint8_t)(v >> 8);
+  return p + 2;
+}
+
+static uint8_t *putU32(uint8_t *p, uint32_t v) {
+  return putU16(putU16(p, v), v >> 16);
+}
+
+static uint32_t getU16(const uint8_t *p) {
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8);
+}
+
+static uint32_t getU32(const uint8_t *p) {
+  return getU16(p) | (getU16(p + 2) << 16);
+}
+
+// -------------------- RECORD --------------------
+void traceRecordBegin(TraceSink s) {
+  sink = s;
+  bufLen = 0;
+  haveLast = false;
+  status = {TRACE_RECORD, false, false, 0, 0, 0, 0};
+}
+
+void traceFlush() {
+  if (status.mode != TRACE_RECORD || bufLen == 0) return;
+  if (sink) sink(buf, bufLen);
+  status.bytes += bufLen;
+  bufLen = 0;
+}
+
+// Normally drained by traceFlush() from the render task; a buffer that
+// fills first is flushed on the spot, stalling the step rather than
+// dropping records
+static uint8_t *reserve(uint32_t n) {
+  if (bufLen + n > TRACE_BUF_N) {
+    status.stallFlushes++;
+    traceFlush();
+  }
+  return buf + bufLen;
+}
+
+void traceRecordClick() {
+  if (status.mode == TRACE_RECORD) stepClick = true;
+}
+
+static void recordStep() {
+  int16_t cal[4] = {(int16_t)joyCenterX, (int16_t)joyCenterY, (int16_t)joyMinY, (int16_t)joyMaxY};
+  uint32_t dt = stepMs - lastMs;
+  uint8_t flags = stepClick ? TICK_CLICK : 0;
+  if (dt != SIM_STEP_MS) flags |= TICK_DT;
+  if (!haveLast || joyLatest.axisX != lastAxisX || joyLatest.axisY != lastAxisY) flags |= TICK_AXES;
+  if (!haveLast || memcmp(cal, lastCal, sizeof(cal)) != 0) flags |= TICK_CAL;
+
+  uint8_t *start = reserve(TICK_MAX_BYTES);
+  uint8_t *p = start;
+  *p++ = flags;
+  if (flags & TICK_DT) {
+    for (uint32_t v = dt; ; v >>= 7) {
+      if (v < 0x80) { *p++ = (uint8_t)v; break; }
+      *p++ = (uint8_t)(v | 0x80);
+    }
+  }
+  if (flags & TICK_AXES) {
+    uint32_t packed = ((uint32_t)joyLatest.axisX & 0xFFFu) | (((uint32_t)joyLatest.axisY & 0xFFFu) << 12);
+    *p++ = (uint8_t)packed;
+    p = putU16(p, packed >> 8);
+  }
+  if (flags & TICK_CAL) {
+    for (int k = 0; k < 4; k++) p = putU16(p, (uint16_t)cal[k]);
+  }
+  p = putU16(p, foldHash(traceStateHash()));
+  bufLen += (uint32_t)(p - start);
+
+  lastAxisX = joyLatest.axisX;
+  lastAxisY = joyLatest.axisY;
+  memcpy(lastCal, cal, sizeof(cal));
+  haveLast = true;
+}
+
+// -------------------- REPLAY --------------------
+// The trace must outlive the replay; false if the header is not ours
+bool traceReplayBegin(const uint8_t *data, uint32_t len) {
+  status = {TRACE_OFF, false, false, 0, 0, 0, 0};
+  if (!data || len < HEADER_BYTES || getU32(data) != TRACE_MAGIC || getU16(data + 4) != SIM_STEP_MS) {
+    return false;
+  }
+  src = data;
+  srcLen = len;
+  srcPos = HEADER_BYTES;
+  bootRng = getU32(data + 8);
+  bootMs = getU32(data + 12);
+  haveLast = false;
+  status.mode = TRACE_REPLAY;
+  status.bytes = HEADER_BYTES;
+  return true;
+}
+
+bool traceReplaying() {
+  return status.mode == TRACE_REPLAY;
+}
+
+bool traceReplayClick() {
+  return stepReplayed && stepClick;
+}
+
+// Trace used up (or cut short): the stick and button go back to live
+static void finishReplay() {
+  status.mode = TRACE_OFF;
+  status.finished = true;
+  stepReplayed = false;
+}
+
+// Decodes the next step; nothing is applied unless the record is complete
+static bool replayStep() {
+  const uint8_t *p = src + srcPos;
+  const uint8_t *end = src + srcLen;
+  if (p >= end) return false;
+
+  uint8_t flags = *p++;
+  uint32_t dt = SIM_STEP_MS;
+  if (flags & TICK_DT) {
+    dt = 0;
+    for (int shift = 0; ; shift += 7) {
+      if (p >= end || shift > 28) return false;
+      uint8_t b = *p++;
+      dt |= (uint32_t)(b & 0x7F) << shift;
+      if (!(b & 0x80)) break;
+    }
+  }
+  uint32_t need = ((flags & TICK_AXES) ? 3 : 0) + ((flags & TICK_CAL) ? 8 : 0) + 2;
+  if ((uint32_t)(end - p) < need) return false;
+
+  if (flags & TICK_AXES) {
+    uint32_t packed = (uint32_t)p[0] | (getU16(p + 1) << 8);
+    lastAxisX = (int16_t)(packed & 0xFFFu);
+    lastAxisY = (int16_t)(packed >> 12);
+    p += 3;
+  }
+  if (flags & TICK_CAL) {
+    joyCenterX = (int16_t)getU16(p);
+    joyCenterY = (int16_t)getU16(p + 2);
+    joyMinY = (int16_t)getU16(p + 4);
+    joyMaxY = (int16_t)getU16(p + 6);
+    p += 8;
+  }
+  if (flags & (TICK_AXES | TICK_CAL)) injectJoystick(lastAxisX, lastAxisY);
+  expectHash = (uint16_t)getU16(p);
+  p += 2;
+
+  stepClick = (flags & TICK_CLICK) != 0;
+  lastMs += dt;
+  status.bytes += (uint32_t)(p - (src + srcPos));
+  srcPos = (uint32_t)(p - src);
+  return true;
+}
+
+// -------------------- STEP HOOKS --------------------
+// Setup, after seeding and before the world is built: a recording notes
+// the seed and clock, a replay puts the recorded ones in their place
+void traceBoot(uint32_t &clockMs) {
+  if (status.mode == TRACE_REPLAY) {
+    rngState = bootRng;
+    clockMs = bootMs;
+  } else if (status.mode == TRACE_RECORD) {
+    uint8_t *p = reserve(HEADER_BYTES);
+    p = putU32(p, TRACE_MAGIC);
+    p = putU16(p, SIM_STEP_MS);
+    p = putU16(p, 0);
+    p = putU32(p, rngState);
+    putU32(p, clockMs);
+    bufLen += HEADER_BYTES;
+  }
+  lastMs = clockMs;
+}
+
+// Around each simulation step. Returns the step's clock: nowMs itself, or
+// the recorded one while replaying, so stalls replay as they happened.
+uint32_t traceStepBegin(uint32_t nowMs) {
+  stepClick = false;
+  if (status.mode == TRACE_REPLAY) {
+    stepReplayed = replayStep();
+    if (stepReplayed) nowMs = lastMs;
+    else finishReplay();
+  }
+  stepMs = nowMs;
+  return nowMs;
+}
+
+void traceStepEnd() {
+  if (status.mode == TRACE_RECORD) {
+    recordStep();
+    lastMs = stepMs;
+    status.steps++;
+  } else if (stepReplayed) {
+    if (!status.diverged && foldHash(traceStateHash()) != expectHash) {
+      status.diverged = true;
+      status.divergedStep = status.steps;
+    }
+    status.steps++;
+  }
+}
+
+const TraceStatus &traceStatus() {
+  return status;
+}
+
+// -------------------- DEVICE --------------------
+#if defined(ARDUINO_ARCH_RP2040)
+// USB CDC; with no host attached the core skips the write
+static void serialSink(const uint8_t *data, uint32_t len) {
+  Serial.write(data, len);
+}
+#endif
+
+// Device builds start the mode chosen in constants.h; host tools
+// call traceRecordBegin/traceReplayBegin themselves before setup()
+void traceBegin() {
+#if defined(ARDUINO_ARCH_RP2040)
+  if (TRACE_DEVICE_RECORD) {
+    Serial.begin(115200);
+    traceRecordBegin(serialSink);
+  } else if (TRACE_DEVICE_REPLAY) {
+    traceReplayBegin(traceReplayData, traceReplayData_len);
+  }
+#endif
+}
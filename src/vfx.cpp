@@ -1,156 +1,164 @@
-// Pixel Buzz Box - VFX (Trails, Popups, Camera, Pulse)
+// Pixel Buzz Box - VFX (Popups, Camera, Pulse)
 #include "game.h"
 #include <math.h>
 
-// -------------------- TRAIL STATE --------------------
-TrailParticle trail[TRAIL_MAX];
-int trailNextIdx = 0;
-
 // -------------------- SCORE POPUP STATE --------------------
-ScorePopup scorePopups[SCORE_POPUP_N];
+Pool<ScorePopup, SCORE_POPUP_N> scorePopups;
 
 // -------------------- CAMERA STATE --------------------
-float cameraZoom = 1.0f;
-float cameraShakeX = 0.0f;
-float cameraShakeY = 0.0f;
+fix16 cameraZoom = FX_ONE;
+fix16 cameraShakeX = 0;
+fix16 cameraShakeY = 0;
 uint32_t cameraShakeUntilMs = 0;
 uint32_t cameraShakeDurationMs = 0;
-float cameraShakeMagnitude = 0.0f;
+fix16 cameraShakeMagnitude = 0;
+CameraTransform cam;
+
+// -------------------- INTERPOLATION STATE --------------------
+// Camera inputs as of the previous simulation step; rendering blends from
+// these toward the current values.
+static fix16 prevBeeWX = 0, prevBeeWY = 0;
+static fix16 prevBeeVX = 0, prevBeeVY = 0;
+static fix16 prevZoom = FX_ONE;
+static fix16 prevShakeX = 0, prevShakeY = 0;
 
 // -------------------- HIVE PULSE STATE --------------------
 uint32_t hivePulseUntilMs = 0;
 
 // -------------------- CAMERA FUNCTIONS --------------------
-int beeScreenCX() { return tft.width() / 2 + (int)cameraShakeX; }
-int beeScreenCY() { return (tft.height() + HUD_H) / 2 + (int)cameraShakeY; }
+int beeScreenCX() { return cam.centerX; }
+int beeScreenCY() { return cam.centerY; }
 
-void triggerCameraShake(uint32_t nowMs, float magnitude, uint32_t durationMs) {
+void triggerCameraShake(uint32_t nowMs, fix16 magnitude, uint32_t durationMs) {
   cameraShakeUntilMs = nowMs + durationMs;
   cameraShakeDurationMs = durationMs;
   cameraShakeMagnitude = magnitude;
+  timerArm(TIMER_CAMERA_SHAKE, 0, cameraShakeUntilMs, nullptr, true);
 }
 
-void updateCamera(float dt, bool boosting, uint32_t nowMs) {
+void updateCamera(fix16 dt, bool boosting, uint32_t nowMs) {
   // Zoom
-  float targetZoom = boosting ? CAMERA_ZOOM_BOOST : CAMERA_ZOOM_NORMAL;
-  float zoomLerp = clampf(CAMERA_ZOOM_LERP_SPEED * dt, 0.0f, 1.0f);
-  cameraZoom += (targetZoom - cameraZoom) * zoomLerp;
+  fix16 targetZoom = boosting ? CAMERA_ZOOM_BOOST : CAMERA_ZOOM_NORMAL;
+  fix16 zoomLerp = fxClamp(fxMul(CAMERA_ZOOM_LERP_SPEED, dt), 0, FX_ONE);
+  cameraZoom = fxLerp(cameraZoom, targetZoom, zoomLerp);
 
   // Shake
   if ((int32_t)(nowMs - cameraShakeUntilMs) < 0 && cameraShakeDurationMs > 0) {
-    float t = (float)(cameraShakeUntilMs - nowMs) / (float)cameraShakeDurationMs;
-    t = clampf(t, 0.0f, 1.0f);
-    float amp = cameraShakeMagnitude * t * t;
-    float phase = (float)nowMs * CAMERA_SHAKE_PHASE_MULT;
-    cameraShakeX = sinf(phase * CAMERA_SHAKE_FREQ_X) * amp;
-    cameraShakeY = cosf(phase * CAMERA_SHAKE_FREQ_Y) * amp;
+    fix16 t = fxRatio((int32_t)(cameraShakeUntilMs - nowMs), (int32_t)cameraShakeDurationMs);
+    t = fxClamp(t, 0, FX_ONE);
+    fix16 amp = fxMul(cameraShakeMagnitude, fxMul(t, t));
+    // Angle units per ms for each axis; only the low 16 bits of the product matter
+    static const uint32_t rateX =
+      (uint32_t)(CAMERA_SHAKE_PHASE_MULT * CAMERA_SHAKE_FREQ_X * ANGLE_PER_RADIAN);
+    static const uint32_t rateY =
+      (uint32_t)(CAMERA_SHAKE_PHASE_MULT * CAMERA_SHAKE_FREQ_Y * ANGLE_PER_RADIAN);
+    cameraShakeX = fxMul(fxSin((angle16)(nowMs * rateX)), amp);
+    cameraShakeY = fxMul(fxCos((angle16)(nowMs * rateY)), amp);
   } else {
-    cameraShakeX = 0.0f;
-    cameraShakeY = 0.0f;
+    cameraShakeX = 0;
+    cameraShakeY = 0;
   }
 }
 
+void settleCamera(fix16 dt) {
+  // Ease back to neutral zoom with no shake (bee parked at hive)
+  fix16 zoomLerp = fxClamp(fxMul(CAMERA_ZOOM_LERP_SPEED, dt), 0, FX_ONE);
+  cameraZoom = fxLerp(cameraZoom, CAMERA_ZOOM_NORMAL, zoomLerp);
+  cameraShakeX = 0;
+  cameraShakeY = 0;
+}
+
 void resetCamera() {
-  cameraZoom = 1.0f;
-  cameraShakeX = 0.0f;
-  cameraShakeY = 0.0f;
+  cameraZoom = FX_ONE;
+  cameraShakeX = 0;
+  cameraShakeY = 0;
   cameraShakeUntilMs = 0;
   cameraShakeDurationMs = 0;
-  cameraShakeMagnitude = 0.0f;
+  cameraShakeMagnitude = 0;
+  captureInterpolationState();
+  updateCameraTransform(FX_ONE);
 }
 
 // -------------------- COORDINATE TRANSFORMS --------------------
-void worldToScreen(int32_t wx, int32_t wy, int &sx, int &sy) {
-  float dx = (float)wx - beeWX;
-  float dy = (float)wy - beeWY;
-  sx = beeScreenCX() + (int)(dx * cameraZoom);
-  sy = beeScreenCY() + (int)(dy * cameraZoom);
+void captureInterpolationState() {
+  prevBeeWX = beeWX;
+  prevBeeWY = beeWY;
+  prevBeeVX = beeVX;
+  prevBeeVY = beeVY;
+  prevZoom = cameraZoom;
+  prevShakeX = cameraShakeX;
+  prevShakeY = cameraShakeY;
 }
 
-void worldToScreenF(float wx, float wy, int &sx, int &sy) {
-  float dx = wx - beeWX;
-  float dy = wy - beeWY;
-  sx = beeScreenCX() + (int)(dx * cameraZoom);
-  sy = beeScreenCY() + (int)(dy * cameraZoom);
+void interpolateBeeVelocity(fix16 alpha, fix16 &vx, fix16 &vy) {
+  vx = fxLerp(prevBeeVX, beeVX, alpha);
+  vy = fxLerp(prevBeeVY, beeVY, alpha);
 }
 
-uint32_t worldCellSeed(int32_t cx, int32_t cy, uint32_t salt) {
-  return hash32((uint32_t)cx * 73856093u ^ (uint32_t)cy * 19349663u ^ salt);
+static void buildCameraTransform(fix16 originX, fix16 originY, fix16 zoom, fix16 shakeX, fix16 shakeY,
+                                 fix16 aheadSec) {
+  cam.originX = originX;
+  cam.originY = originY;
+  cam.zoom = zoom;
+  cam.invZoom = fxDiv(FX_ONE, zoom);
+  cam.centerX = (int16_t)(tft.width() / 2 + fxTrunc(shakeX));
+  cam.centerY = (int16_t)((tft.height() + HUD_H) / 2 + fxTrunc(shakeY));
+  cam.aheadSec = aheadSec;
 }
 
-// -------------------- TRAIL FUNCTIONS --------------------
-void spawnTrailParticle(float wx, float wy, float speedN, uint32_t nowMs) {
-  trail[trailNextIdx].wx = wx;
-  trail[trailNextIdx].wy = wy;
-  trail[trailNextIdx].bornMs = nowMs;
-  trail[trailNextIdx].alive = 1;
-  trail[trailNextIdx].variant = (uint8_t)(xrnd() % 3);
-  trail[trailNextIdx].speedN = clampf(speedN, 0.0f, 1.0f);
-  trailNextIdx = (trailNextIdx + 1) % TRAIL_MAX;
+// alpha in [0, 1]: 0 = previous sim step, 1 = latest sim step
+void updateCameraTransform(fix16 alpha) {
+  buildCameraTransform(fxLerp(prevBeeWX, beeWX, alpha), fxLerp(prevBeeWY, beeWY, alpha),
+                       fxLerp(prevZoom, cameraZoom, alpha),
+                       fxLerp(prevShakeX, cameraShakeX, alpha), fxLerp(prevShakeY, cameraShakeY, alpha),
+                       fxMul(alpha - FX_ONE, SIM_DT));
 }
 
-void updateTrailParticles(uint32_t nowMs) {
-  for (int i = 0; i < TRAIL_MAX; i++) {
-    if (!trail[i].alive) continue;
-    if ((uint32_t)(nowMs - trail[i].bornMs) > TRAIL_LIFE_MS) {
-      trail[i].alive = 0;
-    }
-  }
+// Camera pinned to a predicted bee position (late-latched rendering),
+// aheadSec past the latest sim step
+void updateCameraTransformAt(fix16 originX, fix16 originY, fix16 aheadSec) {
+  buildCameraTransform(originX, originY, cameraZoom, cameraShakeX, cameraShakeY, aheadSec);
 }
 
-bool anyTrailAlive() {
-  for (int i = 0; i < TRAIL_MAX; i++) {
-    if (trail[i].alive) return true;
-  }
-  return false;
+void worldToScreen(int32_t wx, int32_t wy, int &sx, int &sy) {
+  sx = cam.centerX + fxTrunc(fxMul(fxFromInt(wx) - cam.originX, cam.zoom));
+  sy = cam.centerY + fxTrunc(fxMul(fxFromInt(wy) - cam.originY, cam.zoom));
 }
 
-// -------------------- SCORE POPUP FUNCTIONS --------------------
-void spawnScorePopup(uint32_t nowMs, uint8_t value, int sx, int sy) {
-  int freeIdx = -1;
-  uint32_t oldest = 0xFFFFFFFFu;
-  int oldestIdx = 0;
+void worldToScreenFx(fix16 wx, fix16 wy, int &sx, int &sy) {
+  sx = cam.centerX + fxTrunc(fxMul(wx - cam.originX, cam.zoom));
+  sy = cam.centerY + fxTrunc(fxMul(wy - cam.originY, cam.zoom));
+}
 
-  for (int i = 0; i < SCORE_POPUP_N; i++) {
-    if (!scorePopups[i].alive) { freeIdx = i; break; }
-    if (scorePopups[i].bornMs < oldest) { oldest = scorePopups[i].bornMs; oldestIdx = i; }
-  }
+uint32_t worldCellSeed(int32_t cx, int32_t cy, uint32_t salt) {
+  return hash32((uint32_t)cx * 73856093u ^ (uint32_t)cy * 19349663u ^ salt);
+}
 
-  int idx = (freeIdx >= 0) ? freeIdx : oldestIdx;
-  scorePopups[idx].alive = 1;
+// -------------------- SCORE POPUP FUNCTIONS --------------------
+static void expireScorePopup(uint16_t idx) {
+  scorePopups.release(idx);
+}
+
+void spawnScorePopup(uint32_t nowMs, uint8_t value, int sx, int sy) {
+  int idx = scorePopups.acquireOrEvict();
   scorePopups[idx].bornMs = nowMs;
   scorePopups[idx].value = value;
   scorePopups[idx].baseSX = (int16_t)sx;
   scorePopups[idx].baseSY = (int16_t)sy;
   scorePopups[idx].driftX = (int8_t)irand(SCORE_POPUP_DRIFT_MIN, SCORE_POPUP_DRIFT_MAX);
-}
-
-void updateScorePopups(uint32_t nowMs) {
-  for (int i = 0; i < SCORE_POPUP_N; i++) {
-    if (!scorePopups[i].alive) continue;
-    if ((uint32_t)(nowMs - scorePopups[i].bornMs) > SCORE_POPUP_LIFE_MS) {
-      scorePopups[i].alive = 0;
-    }
-  }
-}
-
-bool anyScorePopupAlive() {
-  for (int i = 0; i < SCORE_POPUP_N; i++) {
-    if (scorePopups[i].alive) return true;
-  }
-  return false;
+  timerArm(TIMER_SCORE_POPUP, (uint16_t)idx, nowMs + SCORE_POPUP_LIFE_MS + 1, expireScorePopup, true);
 }
 
 // -------------------- HIVE PULSE --------------------
 void triggerHivePulse(uint32_t nowMs) {
   hivePulseUntilMs = nowMs + HIVE_PULSE_MS;
+  timerArm(TIMER_HIVE_PULSE, 0, hivePulseUntilMs, nullptr, true);
+  emitParticles(EMIT_HIVE_DEBRIS, 0, 0, 0, 0, 0, 6);
 }
 
 // -------------------- RESET --------------------
 void resetVFX() {
-  for (int i = 0; i < TRAIL_MAX; i++) trail[i].alive = 0;
-  for (int i = 0; i < SCORE_POPUP_N; i++) scorePopups[i].alive = 0;
-  trailNextIdx = 0;
+  scorePopups.clear();
   hivePulseUntilMs = 0;
   resetCamera();
 }
@@ -0,0 +1,237 @@
+// Pixel Buzz Box - Wasps (Hard Mode Swarm, Boids, Sprites)
+#include "game.h"
+#include "BuzzSynth.h"
+
+// -------------------- SWARM STORAGE --------------------
+// Struct-of-arrays, packed into [0, waspLive). The steering pass reads
+// neighbour positions and velocities only, and writes the next velocities
+// aside so every wasp sees its neighbours as they were.
+static fix16 waspX[WASP_MAX], waspY[WASP_MAX];       // World position
+static fix16 waspVX[WASP_MAX], waspVY[WASP_MAX];     // World units/s
+static fix16 waspNextVX[WASP_MAX], waspNextVY[WASP_MAX];   // Steering output for this step
+static int8_t waspTarget[WASP_MAX];                  // Flower pool slot, -1 = patrol the hive
+static int16_t waspSX[WASP_MAX], waspSY[WASP_MAX];   // Screen position, per frame
+static int waspLive = 0;
+static int targetCursor = 0;                         // Round-robin flower retargeting
+static uint32_t stingReadyMs = 0;
+
+// Uniform neighbour grid, keyed by wasp index
+static SpatialHash<WASP_MAX, WASP_GRID_BUCKETS, WASP_GRID_CELL> waspGrid;
+
+bool waspsEnabled = false;
+
+// -------------------- SPRITE CACHE --------------------
+// Drawn once with GFX primitives, then blitted with a 1-bit mask:
+// two wing frames, each facing left and right.
+static const int WASP_SPRITE_W = 11;
+static const int WASP_SPRITE_H = 9;
+static const int WASP_MASK_STRIDE = (WASP_SPRITE_W + 7) / 8;
+static uint16_t waspSprite[4][WASP_SPRITE_W * WASP_SPRITE_H];
+static uint8_t waspMask[4][WASP_MASK_STRIDE * WASP_SPRITE_H];
+static bool spritesBuilt = false;
+
+static void buildWaspSprites() {
+  static const uint16_t key = rgb565(255, 0, 255);
+  uint16_t body = rgb565(255, 170, 20);
+  uint16_t wing = rgb565(200, 230, 255);
+  GFXcanvas16 scratch(WASP_SPRITE_W, WASP_SPRITE_H);
+
+  for (int s = 0; s < 4; s++) {
+    bool wingsUp = (s & 1) != 0;
+    bool facingLeft = (s & 2) != 0;
+    scratch.fillScreen(key);
+    scratch.fillCircle(5, wingsUp ? 1 : 3, 2, wing);
+    scratch.fillRect(2, 4, 7, 3, body);
+    scratch.drawFastVLine(4, 4, 3, COL_BLK);
+    scratch.drawFastVLine(6, 4, 3, COL_BLK);
+    scratch.fillRect(8, 4, 2, 2, COL_BLK);        // Head
+    scratch.drawPixel(1, 6, COL_BLK);             // Stinger
+    scratch.drawPixel(0, 7, COL_BLK);
+
+    const uint16_t *src = scratch.getBuffer();
+    uint8_t *mask = waspMask[s];
+    for (int i = 0; i < WASP_MASK_STRIDE * WASP_SPRITE_H; i++) mask[i] = 0;
+    for (int y = 0; y < WASP_SPRITE_H; y++) {
+      for (int x = 0; x < WASP_SPRITE_W; x++) {
+        int sx = facingLeft ? (WASP_SPRITE_W - 1 - x) : x;
+        uint16_t c = src[y * WASP_SPRITE_W + sx];
+        waspSprite[s][y * WASP_SPRITE_W + x] = c;
+        if (c != key) mask[y * WASP_MASK_STRIDE + (x >> 3)] |= (uint8_t)(0x80u >> (x & 7));
+      }
+    }
+  }
+  spritesBuilt = true;
+}
+
+// -------------------- LIFECYCLE --------------------
+// Groups of four enter from the edge of the roaming area
+void spawnWasps(int count) {
+  if (count > WASP_MAX) count = WASP_MAX;
+  waspGrid.clear();
+  waspLive = count;
+  targetCursor = 0;
+  stingReadyMs = 0;
+
+  static const int32_t edge = (int32_t)BOUNDARY_COMFORTABLE;
+  angle16 groupAng = 0;
+  for (int i = 0; i < waspLive; i++) {
+    if ((i & 3) == 0) groupAng = (angle16)xrnd();
+    int32_t wx = icosScaled(groupAng, edge) + irand(-12, 12);
+    int32_t wy = isinScaled(groupAng, edge) + irand(-12, 12);
+    waspX[i] = fxFromInt(wx);
+    waspY[i] = fxFromInt(wy);
+    waspVX[i] = 0;
+    waspVY[i] = 0;
+    waspTarget[i] = -1;
+    waspGrid.insert(i, wx, wy);
+  }
+}
+
+void resetWasps() {
+  if (!spritesBuilt) buildWaspSprites();
+  spawnWasps(waspsEnabled ? WASP_COUNT_HARD : 0);
+}
+
+int waspCount() {
+  return waspLive;
+}
+
+// -------------------- STEERING --------------------
+// Velocity that heads for (tx, ty), or circles it once within orbitR
+static void desiredVelocity(fix16 x, fix16 y, fix16 tx, fix16 ty, int32_t orbitR, fix16 speed,
+                            fix16 &dvx, fix16 &dvy) {
+  fix16 dx = tx - x;
+  fix16 dy = ty - y;
+  fix16 dist = fxHypot(dx, dy);
+  if (dist < FX_ONE) { dvx = 0; dvy = 0; return; }
+  fix16 scale = fxDiv(speed, dist);
+  if (dist < fxFromInt(orbitR)) {
+    dvx = fxMul(-dy, scale);
+    dvy = fxMul(dx, scale);
+  } else {
+    dvx = fxMul(dx, scale);
+    dvy = fxMul(dy, scale);
+  }
+}
+
+static void steerWasp(int i, fix16 dt) {
+  fix16 x = waspX[i], y = waspY[i];
+  fix16 vx = waspVX[i], vy = waspVY[i];
+  fix16 ax = 0, ay = 0;
+
+  // Flock: cohesion, alignment and separation over grid neighbours
+  int16_t nb[WASP_NEIGHBOR_MAX + 1];
+  int n = waspGrid.queryRadius(fxTrunc(x), fxTrunc(y), WASP_NEIGHBOR_RADIUS, nb, WASP_NEIGHBOR_MAX + 1);
+  fix16 offX = 0, offY = 0, velX = 0, velY = 0, sepX = 0, sepY = 0;
+  int mates = 0;
+  for (int k = 0; k < n; k++) {
+    int j = nb[k];
+    if (j == i) continue;
+    fix16 dx = waspX[j] - x;
+    fix16 dy = waspY[j] - y;
+    offX += dx;
+    offY += dy;
+    velX += waspVX[j];
+    velY += waspVY[j];
+    int32_t ix = fxTrunc(dx), iy = fxTrunc(dy);
+    if (ix*ix + iy*iy < WASP_SEPARATION_RADIUS * WASP_SEPARATION_RADIUS) {
+      sepX -= dx;
+      sepY -= dy;
+    }
+    mates++;
+  }
+  if (mates > 0) {
+    ax += fxMul(offX / mates, WASP_COHESION) + fxMul(velX / mates - vx, WASP_ALIGNMENT);
+    ay += fxMul(offY / mates, WASP_COHESION) + fxMul(velY / mates - vy, WASP_ALIGNMENT);
+    ax += fxMul(sepX, WASP_SEPARATION);
+    ay += fxMul(sepY, WASP_SEPARATION);
+  }
+
+  // Goal: hunt a nearby bee, else circle the assigned flower or the hive
+  fix16 dvx, dvy;
+  int32_t bdx = fxTrunc(beeWX - x), bdy = fxTrunc(beeWY - y);
+  int t = waspTarget[i];
+  if (!isUnloading && bdx*bdx + bdy*bdy < WASP_CHASE_RADIUS * WASP_CHASE_RADIUS) {
+    desiredVelocity(x, y, beeWX, beeWY, 0, WASP_SPEED_CHASE, dvx, dvy);
+  } else if (t >= 0 && flowers.alive(t)) {
+    desiredVelocity(x, y, fxFromInt(flowers[t].wx), fxFromInt(flowers[t].wy), WASP_ORBIT_RADIUS,
+                    WASP_SPEED_PATROL, dvx, dvy);
+  } else {
+    desiredVelocity(x, y, 0, 0, WASP_HIVE_CLEAR * 2, WASP_SPEED_PATROL, dvx, dvy);
+  }
+  ax += fxMul(dvx - vx, WASP_STEER_GAIN);
+  ay += fxMul(dvy - vy, WASP_STEER_GAIN);
+
+  // The hive is off limits
+  int32_t hx = fxTrunc(x), hy = fxTrunc(y);
+  if (hx*hx + hy*hy < WASP_HIVE_CLEAR * WASP_HIVE_CLEAR) {
+    ax += fxMul(x, WASP_HIVE_PUSH);
+    ay += fxMul(y, WASP_HIVE_PUSH);
+  }
+
+  vx += fxMul(ax, dt);
+  vy += fxMul(ay, dt);
+  fix16 speed = fxHypot(vx, vy);
+  if (speed > WASP_SPEED_CHASE) {
+    fix16 scale = fxDiv(WASP_SPEED_CHASE, speed);
+    vx = fxMul(vx, scale);
+    vy = fxMul(vy, scale);
+  }
+  waspNextVX[i] = vx;
+  waspNextVY[i] = vy;
+}
+
+// -------------------- UPDATE --------------------
+// Steer everyone from the same snapshot of positions, velocities and the
+// grid, sting from it too, then move and re-bin.
+void updateWasps(fix16 dt, uint32_t nowMs) {
+  if (waspLive == 0) return;
+
+  // One wasp per step picks the flower nearest to it
+  int r = targetCursor++ % waspLive;
+  waspTarget[r] = (int8_t)flowerGrid.nearest(fxTrunc(waspX[r]), fxTrunc(waspY[r]));
+
+  for (int i = 0; i < waspLive; i++) steerWasp(i, dt);
+
+  bool canSting = !isUnloading && !isGameOver && (int32_t)(nowMs - stingReadyMs) >= 0;
+  for (int i = 0; i < waspLive; i++) {
+    if (canSting && beeTouches(fxTrunc(waspX[i]), fxTrunc(waspY[i]), WASP_HIT_RADIUS)) {
+      canSting = false;
+      stingReadyMs = nowMs + WASP_STING_COOLDOWN_MS;
+      addSurvivalTime(nowMs, -WASP_STING_SECONDS);
+      triggerCameraShake(nowMs, CAMERA_SHAKE_MAGNITUDE, CAMERA_SHAKE_DURATION_MS);
+      emitParticles(EMIT_HIVE_DEBRIS, beeWX, beeWY, 0, 0, 0, 4);
+      audioPost(SND_CLICK);
+      // Bounce off so one pass through the bee is one sting; this step
+      // already moves away
+      waspNextVX[i] = -waspNextVX[i];
+      waspNextVY[i] = -waspNextVY[i];
+    }
+
+    waspVX[i] = waspNextVX[i];
+    waspVY[i] = waspNextVY[i];
+    waspX[i] += fxMul(waspVX[i], dt);
+    waspY[i] += fxMul(waspVY[i], dt);
+    waspGrid.insert(i, fxTrunc(waspX[i]), fxTrunc(waspY[i]));
+  }
+}
+
+// -------------------- RENDER --------------------
+void projectWasps() {
+  for (int i = 0; i < waspLive; i++) {
+    int sx, sy;
+    worldToScreenFx(waspX[i], waspY[i], sx, sy);
+    waspSX[i] = (int16_t)clampi(sx, -1000, 1000);
+    waspSY[i] = (int16_t)clampi(sy, -1000, 1000);
+  }
+}
+
+void drawWasps(Adafruit_GFX &g, int ox, int oy, uint32_t nowMs) {
+  for (int i = 0; i < waspLive; i++) {
+    int x = waspSX[i] + ox - WASP_SPRITE_W / 2;
+    int y = waspSY[i] + oy - WASP_SPRITE_H / 2;
+    if (x < -WASP_SPRITE_W || x > CANVAS_W || y < -WASP_SPRITE_H || y > CANVAS_H) continue;
+    int s = (int)(((nowMs >> 5) + (uint32_t)i) & 1u) | (waspVX[i] < 0 ? 2 : 0);
+    g.drawRGBBitmap(x, y, waspSprite[s], waspMask[s], WASP_SPRITE_W, WASP_SPRITE_H);
+  }
+}
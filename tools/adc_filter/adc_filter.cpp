@@ -0,0 +1,135 @@
+// Pixel Buzz Box - ADC Filter Check (Stick Stream Noise and Step Response)
+//
+// Drives the real ADC stream (src/adcstream.cpp) through its host sample
+// source on the DMA timeline and reads it as the input task does, then
+// checks that the IIR really filters and that its lag stays bounded:
+//
+//   pio run -e adc_filter
+//   .pio/build/adc_filter/program
+//
+// Noise: +/-25 LSB uniform noise (10-bit scale) on a resting stick, read
+// every 2 ms; the filtered spread must sit well under the plain 8-pair
+// box average's. Step: a half-scale step read every 1, 2 and 5 ms; the
+// 10-90% rise at the input period must stay within bounds, and the 50%
+// delay must not depend on the read period (the IIR time constant is in
+// pairs, not reads). Exits 1 on any failure.
+#include "game.h"
+
+static const uint32_t INPUT_READ_US = 2000;        // The input task's period
+static const int NOISE_LSB = 25;                   // 10-bit scale
+static const uint32_t NOISE_READS = 2000;
+static const int STEP_LO = 256, STEP_HI = 768;     // 10-bit scale
+static const uint32_t STEP_AT_US = 100000;
+
+// Bounds
+static const float NOISE_MAX_RATIO = 0.75f;        // Filtered sigma / box-average sigma
+static const float RISE_MIN_MS = 4.0f;             // Faster means the IIR does nothing
+static const float RISE_MAX_MS = 14.0f;            // Slower is felt at the stick
+static const float DELAY_SPREAD_MAX_MS = 2.5f;     // 50% delay across read periods
+
+// -------------------- SOURCES --------------------
+// Deterministic per-sample noise, so runs repeat exactly
+static uint16_t noisySource(uint8_t input, uint32_t tUs) {
+  uint32_t h = hash32(tUs * 2u + input);
+  int n = (int)(h % (uint32_t)(8 * NOISE_LSB + 1)) - 4 * NOISE_LSB;   // 12-bit LSBs
+  return (uint16_t)(2048 + n);
+}
+
+static uint16_t stepSource(uint8_t input, uint32_t tUs) {
+  (void)input;
+  return (uint16_t)(((int32_t)(tUs - STEP_AT_US) >= 0 ? STEP_HI : STEP_LO) << 2);
+}
+
+// -------------------- NOISE --------------------
+static bool checkNoise() {
+  hostSetMicros(0);
+  adcStreamSetSource(noisySource);
+  adcStreamBegin();
+
+  JoyAxes a;
+  double sum = 0, sum2 = 0;
+  int lo = 1 << 30, hi = -(1 << 30);
+  for (uint32_t r = 0; r < NOISE_READS + 50; r++) {
+    hostAdvanceMicros(INPUT_READ_US);
+    if (!adcStreamRead(a) || r < 50) continue;   // Settle first
+    sum += a.x;
+    sum2 += (double)a.x * a.x;
+    if (a.x < lo) lo = a.x;
+    if (a.x > hi) hi = a.x;
+  }
+  double mean = sum / NOISE_READS;
+  float sigma = (float)sqrt(sum2 / NOISE_READS - mean * mean);
+
+  // Uniform +/-L has sigma L/sqrt(3); the box averages 8 samples per axis
+  float rawSigma = (float)NOISE_LSB / sqrtf(3.0f);
+  float boxSigma = rawSigma / sqrtf((float)ADC_OVERSAMPLE);
+  float ratio = sigma / boxSigma;
+  bool ok = ratio <= NOISE_MAX_RATIO;
+  printf("noise: raw sigma %.2f, box average %.2f, filtered %.2f LSB (ratio %.2f, max %.2f), "
+         "range %d..%d  %s\n", rawSigma, boxSigma, sigma, ratio, NOISE_MAX_RATIO, lo, hi, ok ? "ok" : "FAIL");
+  return ok;
+}
+
+// -------------------- STEP --------------------
+struct StepTimes {
+  float t10, t50, t90;   // ms after the step
+};
+
+// First read time at which the output crossed each level; linear in
+// between reads so the figures do not snap to the read period
+static StepTimes measureStep(uint32_t readUs) {
+  hostSetMicros(0);
+  adcStreamSetSource(stepSource);
+  adcStreamBegin();
+
+  const float levels[3] = {0.1f, 0.5f, 0.9f};
+  float times[3] = {-1, -1, -1};
+  float prevT = 0, prevV = 0;
+  JoyAxes a;
+  for (uint32_t t = readUs; t < STEP_AT_US + 100000; t += readUs) {
+    hostSetMicros(t);
+    if (!adcStreamRead(a)) continue;
+    float v = (float)(a.x - STEP_LO) / (float)(STEP_HI - STEP_LO);
+    float tMs = ((float)t - (float)STEP_AT_US) / 1000.0f;
+    for (int k = 0; k < 3; k++) {
+      if (times[k] < 0 && v >= levels[k] && tMs >= 0) {
+        float f = (v > prevV) ? (levels[k] - prevV) / (v - prevV) : 1.0f;
+        times[k] = prevT + (tMs - prevT) * clampf(f, 0.0f, 1.0f);
+      }
+    }
+    prevT = tMs;
+    prevV = v;
+  }
+  return {times[0], times[1], times[2]};
+}
+
+static bool checkStep() {
+  static const uint32_t periods[] = {1000, 2000, 5000};
+  bool ok = true;
+  float minDelay = 1e9f, maxDelay = -1e9f;
+  for (uint32_t p : periods) {
+    StepTimes s = measureStep(p);
+    float rise = s.t90 - s.t10;
+    bool valid = s.t10 >= 0 && s.t50 >= 0 && s.t90 >= 0;
+    bool riseOk = valid && (p != INPUT_READ_US || (rise >= RISE_MIN_MS && rise <= RISE_MAX_MS));
+    printf("step: read every %u ms: 10%% %.1f ms, 50%% %.1f ms, 90%% %.1f ms, rise %.1f ms%s  %s\n",
+           p / 1000, s.t10, s.t50, s.t90, rise,
+           p == INPUT_READ_US ? " (input period)" : "", riseOk ? "ok" : "FAIL");
+    ok = ok && riseOk;
+    if (valid) {
+      if (s.t50 < minDelay) minDelay = s.t50;
+      if (s.t50 > maxDelay) maxDelay = s.t50;
+    }
+  }
+  bool spreadOk = maxDelay - minDelay <= DELAY_SPREAD_MAX_MS;
+  printf("step: 50%% delay spread across read periods %.1f ms (max %.1f)  %s\n", maxDelay - minDelay,
+         DELAY_SPREAD_MAX_MS, spreadOk ? "ok" : "FAIL");
+  return ok && spreadOk;
+}
+
+int main() {
+  bool ok = checkNoise();
+  ok = checkStep() && ok;
+  printf("%s\n", ok ? "PASS" : "FAIL");
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,121 @@
+// Pixel Buzz Box - Camera Check (Fixed-Point World->Screen vs Float)
+//
+// Builds the camera transform through the game's own path (src/vfx.cpp)
+// over a sweep of zooms, camera positions and shakes, projects points
+// across and around the view with worldToScreen/worldToScreenFx, and
+// compares each with the float projection the Q16.16 code replaced:
+//
+//   pio run -e camera_check
+//   .pio/build/camera_check/program
+//
+// The float reference sees the same camera state converted back from
+// fix16, so the check covers the transform itself (zoom multiply, shake
+// and centre rounding), not state drift. Exits 1 if any point is off by
+// more than MAX_ERR_PX on either axis.
+#include "game.h"
+
+static const int MAX_ERR_PX = 1;
+static const float ZOOM_MIN = 0.5f, ZOOM_MAX = 2.0f;
+static const int ZOOM_STEPS = 61;                  // Includes 1.0 and boost zoom region
+static const float ORIGIN_RANGE = 12000.0f;        // World units either side of 0
+static const int ORIGINS_PER_ZOOM = 200;
+static const int POINTS_PER_CAMERA = 400;
+static const float VIEW_MARGIN_PX = 64.0f;         // Project a little past the panel edges
+
+// -------------------- FLOAT REFERENCE --------------------
+// The pre-fixed-point projection: float delta times zoom, truncated,
+// added to the panel centre plus truncated shake
+struct FloatCamera {
+  float originX, originY, zoom, shakeX, shakeY;
+};
+
+static void floatToScreen(const FloatCamera &c, float wx, float wy, int &sx, int &sy) {
+  sx = tft.width() / 2 + (int)c.shakeX + (int)((wx - c.originX) * c.zoom);
+  sy = (tft.height() + HUD_H) / 2 + (int)c.shakeY + (int)((wy - c.originY) * c.zoom);
+}
+
+// -------------------- SWEEP --------------------
+static uint32_t sweepSeed = 0x51ED270Bu;
+
+// Uniform in [lo, hi), deterministic
+static float sweepRand(float lo, float hi) {
+  sweepSeed = hash32(sweepSeed);
+  return lo + (hi - lo) * (float)(sweepSeed >> 8) * (1.0f / 16777216.0f);
+}
+
+struct Stats {
+  uint32_t points = 0;
+  uint32_t offByOne = 0;
+  int maxErr = 0;
+  float worstZoom = 0, worstWX = 0, worstWY = 0;
+};
+
+static void compare(Stats &st, const FloatCamera &fc, fix16 wx, fix16 wy, int fsx, int fsy) {
+  int rsx, rsy;
+  floatToScreen(fc, fxToFloat(wx), fxToFloat(wy), rsx, rsy);
+  int err = abs(fsx - rsx) > abs(fsy - rsy) ? abs(fsx - rsx) : abs(fsy - rsy);
+  st.points++;
+  if (err == 1) st.offByOne++;
+  if (err > st.maxErr) {
+    st.maxErr = err;
+    st.worstZoom = fc.zoom;
+    st.worstWX = fxToFloat(wx);
+    st.worstWY = fxToFloat(wy);
+  }
+}
+
+int main() {
+  tft.init(240, 320);
+  tft.setRotation(1);
+
+  Stats whole, frac;
+  for (int z = 0; z < ZOOM_STEPS; z++) {
+    fix16 zoom = fxFromFloat(ZOOM_MIN + (ZOOM_MAX - ZOOM_MIN) * (float)z / (float)(ZOOM_STEPS - 1));
+    for (int o = 0; o < ORIGINS_PER_ZOOM; o++) {
+      beeWX = fxFromFloat(sweepRand(-ORIGIN_RANGE, ORIGIN_RANGE));
+      beeWY = fxFromFloat(sweepRand(-ORIGIN_RANGE, ORIGIN_RANGE));
+      cameraZoom = zoom;
+      // Every other camera shaken, up to the full magnitude
+      float mag = (o & 1) ? fxToFloat(CAMERA_SHAKE_MAGNITUDE) : 0.0f;
+      cameraShakeX = fxFromFloat(sweepRand(-mag, mag));
+      cameraShakeY = fxFromFloat(sweepRand(-mag, mag));
+      captureInterpolationState();
+      updateCameraTransform(FX_ONE);
+
+      FloatCamera fc = {fxToFloat(beeWX), fxToFloat(beeWY), fxToFloat(zoom),
+                        fxToFloat(cameraShakeX), fxToFloat(cameraShakeY)};
+      float halfW = ((float)tft.width() / 2 + VIEW_MARGIN_PX) / fc.zoom;
+      float halfH = ((float)tft.height() / 2 + VIEW_MARGIN_PX) / fc.zoom;
+
+      for (int p = 0; p < POINTS_PER_CAMERA; p++) {
+        // Whole world units (flowers, hive)
+        int32_t ix = (int32_t)floorf(fc.originX + sweepRand(-halfW, halfW));
+        int32_t iy = (int32_t)floorf(fc.originY + sweepRand(-halfH, halfH));
+        int sx, sy;
+        worldToScreen(ix, iy, sx, sy);
+        compare(whole, fc, fxFromInt(ix), fxFromInt(iy), sx, sy);
+
+        // Fractional positions (wasps, particles)
+        fix16 wx = fxFromFloat(fc.originX + sweepRand(-halfW, halfW));
+        fix16 wy = fxFromFloat(fc.originY + sweepRand(-halfH, halfH));
+        worldToScreenFx(wx, wy, sx, sy);
+        compare(frac, fc, wx, wy, sx, sy);
+      }
+    }
+  }
+
+  bool ok = true;
+  const Stats *all[2] = {&whole, &frac};
+  const char *names[2] = {"worldToScreen  ", "worldToScreenFx"};
+  for (int k = 0; k < 2; k++) {
+    const Stats &st = *all[k];
+    bool pass = st.maxErr <= MAX_ERR_PX;
+    printf("%s %u points, zoom %.2f..%.2f: %.3f%% off by 1 px, max %d px (limit %d)",
+           names[k], st.points, ZOOM_MIN, ZOOM_MAX, 100.0 * st.offByOne / st.points, st.maxErr, MAX_ERR_PX);
+    if (st.maxErr > 0) printf(", worst at zoom %.3f (%.2f, %.2f)", st.worstZoom, st.worstWX, st.worstWY);
+    printf("  %s\n", pass ? "ok" : "FAIL");
+    ok = ok && pass;
+  }
+  printf("%s\n", ok ? "PASS" : "FAIL");
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,373 @@
+// Pixel Buzz Box - Frame Check (Golden Frame Hashes for the Renderer)
+//
+// Runs the real game (src/*.cpp) through scripted scenarios on the host
+// stand-ins and hashes the composed panel frame at fixed times, then
+// compares each hash with tools/frame_check/golden.txt. Every scenario
+// runs in its own forked process, so each starts from a fresh boot.
+//
+//   pio run -e frame_check
+//   .pio/build/frame_check/program [--golden FILE] [--update]
+//       [--save DIR] [--ref DIR] [--tolerance PX] [--delta D] [--out DIR]
+//       [--trace NAME=FILE]... [--only NAME]
+//
+// --update rewrites the golden file from this build. A hash mismatch
+// fails, unless --ref holds the same frame saved (--save) by a baseline
+// build and at most PX pixels differ by more than D per 8-bit channel.
+// Either way, mismatches are reported with the pixel count, worst delta
+// and bounding box. Failures dump the frame and a diff image (reference
+// dimmed, differing pixels in red) to --out. --trace adds a scenario
+// that replays an input trace (trace.cpp), captured every 500 ms.
+//
+// Time is virtual and tasks take no time, so frame timing does not
+// depend on how fast the renderer is; only its pixels are compared.
+#include "game.h"
+#include <map>
+#include <string>
+#include <vector>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+void setup();
+void loop();
+
+static const uint32_t CLICK_HOLD_MS = 60;
+static const uint32_t TRACE_CAPTURE_MS = 500;
+static const int CAPTURE_MAX = 8;
+
+// -------------------- SCENARIOS --------------------
+// Scripted inputs plus an optional poke at the game state, then frames
+// captured at the first completed frame at or after each time
+struct Scenario {
+  const char *name;
+  int stickX, stickY;           // Held from the end of setup()
+  uint32_t clickMs;             // 0 = no press
+  uint32_t pokeMs;
+  void (*poke)();               // nullptr = none
+  uint32_t captureMs[CAPTURE_MAX];
+  int captures;
+  const char *tracePath;        // Replays this trace instead of the script
+};
+
+static void pokePollen() { pollenCount = 3; }   // Bee waits at the hive: unload starts
+
+static void pokeWasps() {
+  waspsEnabled = true;
+  spawnWasps(WASP_COUNT_HARD);
+}
+
+static void pokeGameOver() { survivalTimeLeft = 0.0f; }
+
+static std::vector<Scenario> builtinScenarios() {
+  return {
+    {"idle",     512,  512,    0,   0, nullptr,      {100, 600, 1500}, 3, nullptr},
+    {"fly",      900,  200, 1500,   0, nullptr,      {500, 1000, 1600, 2500, 4000}, 5, nullptr},
+    {"unload",   512,  512,    0, 400, pokePollen,   {500, 700, 1200, 2500}, 4, nullptr},
+    {"wasps",    200,  800,    0,   0, pokeWasps,    {300, 1000, 2500}, 3, nullptr},
+    {"gameover", 512,  512,    0, 300, pokeGameOver, {400, 900, 1700}, 3, nullptr},
+  };
+}
+
+// -------------------- OPTIONS --------------------
+struct Options {
+  const char *goldenPath = "tools/frame_check/golden.txt";
+  const char *saveDir = nullptr;
+  const char *refDir = nullptr;
+  const char *outDir = "frame_check_out";
+  const char *only = nullptr;
+  uint32_t tolerancePx = 0;
+  int delta = 0;
+  bool update = false;
+  std::vector<Scenario> traces;
+  std::vector<std::string> traceNames;   // Own the --trace names
+};
+
+static bool parseArgs(int argc, char **argv, Options &o) {
+  for (int i = 1; i < argc; i++) {
+    const char *a = argv[i];
+    bool more = i + 1 < argc;
+    if (!strcmp(a, "--golden") && more) o.goldenPath = argv[++i];
+    else if (!strcmp(a, "--update")) o.update = true;
+    else if (!strcmp(a, "--save") && more) o.saveDir = argv[++i];
+    else if (!strcmp(a, "--ref") && more) o.refDir = argv[++i];
+    else if (!strcmp(a, "--out") && more) o.outDir = argv[++i];
+    else if (!strcmp(a, "--only") && more) o.only = argv[++i];
+    else if (!strcmp(a, "--tolerance") && more) o.tolerancePx = (uint32_t)strtoul(argv[++i], nullptr, 10);
+    else if (!strcmp(a, "--delta") && more) o.delta = atoi(argv[++i]);
+    else if (!strcmp(a, "--trace") && more) {
+      const char *spec = argv[++i];
+      const char *eq = strchr(spec, '=');
+      if (!eq || eq == spec) return false;
+      o.traceNames.push_back(std::string(spec, eq));
+      Scenario s = {nullptr, 512, 512, 0, 0, nullptr, {0}, 0, eq + 1};
+      o.traces.push_back(s);
+    } else return false;
+  }
+  for (size_t k = 0; k < o.traces.size(); k++) o.traces[k].name = o.traceNames[k].c_str();
+  return !(o.update && o.only);   // An update rewrites every scenario
+}
+
+// -------------------- GOLDEN FILE --------------------
+// One line per frame: "<scenario> <ms> <fnv1a64 hex>"; '#' starts a comment
+typedef std::map<std::string, uint64_t> GoldenMap;
+
+static std::string frameKey(const char *scenario, uint32_t ms) {
+  return std::string(scenario) + " " + std::to_string(ms);
+}
+
+static void loadGolden(const char *path, GoldenMap &golden) {
+  FILE *f = fopen(path, "r");
+  if (!f) return;
+  char line[256];
+  while (fgets(line, sizeof(line), f)) {
+    char name[96];
+    unsigned ms;
+    unsigned long long hash;
+    if (line[0] == '#') continue;
+    if (sscanf(line, "%95s %u %llx", name, &ms, &hash) == 3) golden[frameKey(name, ms)] = hash;
+  }
+  fclose(f);
+}
+
+// -------------------- FRAMES --------------------
+static uint64_t frameHash(const uint16_t *px, int n) {
+  uint64_t h = 0xcbf29ce484222325ull;
+  for (int i = 0; i < n; i++) {
+    h = (h ^ (px[i] & 0xFF)) * 0x100000001b3ull;
+    h = (h ^ (px[i] >> 8)) * 0x100000001b3ull;
+  }
+  return h;
+}
+
+static std::string framePath(const char *dir, const char *scenario, uint32_t ms, const char *suffix) {
+  char buf[512];
+  snprintf(buf, sizeof(buf), "%s/%s_%05u%s.ppm", dir, scenario, ms, suffix);
+  return buf;
+}
+
+// Binary 8-bit PPM as written by hostWritePPM
+static bool readPPM(const std::string &path, int w, int h, std::vector<uint8_t> &rgb) {
+  FILE *f = fopen(path.c_str(), "rb");
+  if (!f) return false;
+  int fw, fh, maxv;
+  bool ok = fscanf(f, "P6 %d %d %d", &fw, &fh, &maxv) == 3 && fgetc(f) != EOF
+            && fw == w && fh == h && maxv == 255;
+  if (ok) {
+    rgb.resize((size_t)w * h * 3);
+    ok = fread(rgb.data(), 1, rgb.size(), f) == rgb.size();
+  }
+  fclose(f);
+  return ok;
+}
+
+struct FrameDiff {
+  uint32_t pixels;              // Over the per-channel delta
+  int maxDelta;
+  int x0, y0, x1, y1;           // Bounding box of those pixels
+};
+
+// Diff image: reference at quarter brightness, pixels over delta in red
+static FrameDiff diffFrame(const uint16_t *px, int w, int h, const std::vector<uint8_t> &ref, int delta,
+                           std::vector<uint16_t> &image) {
+  FrameDiff d = {0, 0, w, h, -1, -1};
+  image.resize((size_t)w * h);
+  for (int y = 0; y < h; y++) {
+    for (int x = 0; x < w; x++) {
+      int i = y * w + x;
+      uint8_t cur[3];
+      hostRgb565To888(px[i], cur);
+      const uint8_t *r = &ref[(size_t)i * 3];
+      int worst = 0;
+      for (int c = 0; c < 3; c++) {
+        int dc = abs((int)cur[c] - (int)r[c]);
+        if (dc > worst) worst = dc;
+      }
+      if (worst > d.maxDelta) d.maxDelta = worst;
+      if (worst > delta) {
+        d.pixels++;
+        if (x < d.x0) d.x0 = x;
+        if (y < d.y0) d.y0 = y;
+        if (x > d.x1) d.x1 = x;
+        if (y > d.y1) d.y1 = y;
+        image[i] = rgb565(255, 0, 0);
+      } else {
+        image[i] = rgb565(r[0] >> 2, r[1] >> 2, r[2] >> 2);
+      }
+    }
+  }
+  return d;
+}
+
+// -------------------- CHECK --------------------
+// Returns true when the frame passes; appends its golden line to `out`
+static bool checkFrame(const Options &o, const GoldenMap &golden, const char *scenario, uint32_t ms,
+                       std::string &out) {
+  const uint16_t *px = tft.framebuffer();
+  int w = tft.width(), h = tft.height();
+  uint64_t hash = frameHash(px, w * h);
+
+  char line[160];
+  snprintf(line, sizeof(line), "%s %u %016llx\n", scenario, ms, (unsigned long long)hash);
+  out += line;
+  if (o.saveDir) tft.savePPM(framePath(o.saveDir, scenario, ms, "").c_str());
+  if (o.update) return true;
+
+  auto g = golden.find(frameKey(scenario, ms));
+  if (g != golden.end() && g->second == hash) {
+    printf("  %-10s %5u ms  ok\n", scenario, ms);
+    return true;
+  }
+
+  bool pass = false;
+  std::vector<uint8_t> ref;
+  std::vector<uint16_t> image;
+  bool haveRef = o.refDir && readPPM(framePath(o.refDir, scenario, ms, ""), w, h, ref);
+  if (haveRef) {
+    FrameDiff d = diffFrame(px, w, h, ref, o.delta, image);
+    pass = d.pixels <= o.tolerancePx;
+    printf("  %-10s %5u ms  %s: %u px over delta %d (max delta %d)", scenario, ms,
+           pass ? "within tolerance" : "FAIL", d.pixels, o.delta, d.maxDelta);
+    if (d.pixels) printf(" in [%d,%d]-[%d,%d]", d.x0, d.y0, d.x1, d.y1);
+    printf("\n");
+  } else {
+    printf("  %-10s %5u ms  FAIL: %s\n", scenario, ms,
+           g == golden.end() ? "no golden hash" : "hash differs, no reference frame for a pixel diff");
+  }
+
+  if (!pass) {
+    mkdir(o.outDir, 0755);
+    tft.savePPM(framePath(o.outDir, scenario, ms, "").c_str());
+    if (haveRef) hostWritePPM(framePath(o.outDir, scenario, ms, "_diff").c_str(), image.data(), w, h);
+  }
+  return pass;
+}
+
+// -------------------- RUN --------------------
+static std::vector<uint8_t> traceBytes;
+
+// Child process: boot, drive, capture. Golden lines go to `fd`; the exit
+// code is the number of failed frames.
+static int runScenario(const Options &o, const GoldenMap &golden, Scenario s, int fd) {
+  if (s.tracePath) {
+    FILE *f = fopen(s.tracePath, "rb");
+    uint8_t chunk[4096];
+    size_t n;
+    while (f && (n = fread(chunk, 1, sizeof(chunk), f)) > 0) traceBytes.insert(traceBytes.end(), chunk, chunk + n);
+    if (f) fclose(f);
+    if (!traceReplayBegin(traceBytes.data(), (uint32_t)traceBytes.size())) {
+      printf("  %-10s cannot replay %s\n", s.name, s.tracePath);
+      return 1;
+    }
+  }
+
+  hostSetAnalog(PIN_JOY_VRX, 512);
+  hostSetAnalog(PIN_JOY_VRY, 512);
+  hostSetPin(PIN_JOY_SW, HIGH);
+  setup();
+  audioEnd();   // Stepped inline below
+  hostSetAnalog(PIN_JOY_VRX, s.stickX);
+  hostSetAnalog(PIN_JOY_VRY, s.stickY);
+
+  uint32_t startMs = millis();
+  uint32_t lastTiles = tft.tilesPushed();
+  bool poked = false;
+  int next = 0, failed = 0;
+  std::string out;
+  for (;;) {
+    uint32_t elapsedMs = millis() - startMs;
+    if (s.tracePath) {
+      if (traceStatus().finished) break;
+    } else if (next >= s.captures) {
+      break;
+    }
+    if (s.poke && !poked && elapsedMs >= s.pokeMs) {
+      s.poke();
+      poked = true;
+    }
+    bool down = s.clickMs && elapsedMs >= s.clickMs && elapsedMs < s.clickMs + CLICK_HOLD_MS;
+    hostSetPin(PIN_JOY_SW, down ? LOW : HIGH);
+    loop();
+    audioCoreLoop();
+
+    if (tft.tilesPushed() == lastTiles) continue;
+    lastTiles = tft.tilesPushed();
+    uint32_t atMs = s.tracePath ? (uint32_t)next * TRACE_CAPTURE_MS : s.captureMs[next];
+    if (elapsedMs < atMs) continue;
+    if (!checkFrame(o, golden, s.name, atMs, out)) failed++;
+    next++;
+  }
+  if (s.tracePath && traceStatus().diverged) {
+    printf("  %-10s trace diverged at step %u\n", s.name, traceStatus().divergedStep);
+    failed++;
+  }
+
+  if (write(fd, out.data(), out.size()) != (ssize_t)out.size()) failed++;
+  return failed > 255 ? 255 : failed;
+}
+
+static std::string readAll(int fd) {
+  std::string s;
+  char buf[4096];
+  ssize_t n;
+  while ((n = read(fd, buf, sizeof(buf))) > 0) s.append(buf, (size_t)n);
+  return s;
+}
+
+// -------------------- MAIN --------------------
+int main(int argc, char **argv) {
+  Options o;
+  if (!parseArgs(argc, argv, o)) {
+    fprintf(stderr, "usage: %s [--golden FILE] [--update] [--save DIR] [--ref DIR] [--tolerance PX] "
+                    "[--delta D] [--out DIR] [--trace NAME=FILE]... [--only NAME]\n", argv[0]);
+    return 2;
+  }
+  if (o.saveDir) mkdir(o.saveDir, 0755);
+
+  GoldenMap golden;
+  loadGolden(o.goldenPath, golden);
+
+  std::vector<Scenario> scenarios = builtinScenarios();
+  scenarios.insert(scenarios.end(), o.traces.begin(), o.traces.end());
+
+  std::string lines = "# Pixel Buzz Box golden frames: scenario, capture ms, FNV-1a 64 of the RGB565 panel\n"
+                      "# Regenerate with: frame_check --update\n";
+  int failed = 0, ran = 0;
+  for (const Scenario &s : scenarios) {
+    if (o.only && strcmp(o.only, s.name) != 0) continue;
+    int fds[2];
+    if (pipe(fds) != 0) return 2;
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid < 0) return 2;
+    if (pid == 0) {
+      close(fds[0]);
+      int rc = runScenario(o, golden, s, fds[1]);
+      fflush(stdout);
+      _exit(rc);
+    }
+    close(fds[1]);
+    lines += readAll(fds[0]);
+    close(fds[0]);
+    int status = 0;
+    waitpid(pid, &status, 0);
+    if (!WIFEXITED(status)) {
+      printf("  %-10s crashed\n", s.name);
+      failed++;
+    } else {
+      failed += WEXITSTATUS(status);
+    }
+    ran++;
+  }
+
+  if (o.update) {
+    FILE *f = fopen(o.goldenPath, "w");
+    if (!f || fputs(lines.c_str(), f) < 0 || fclose(f) != 0) {
+      fprintf(stderr, "cannot write %s\n", o.goldenPath);
+      return 2;
+    }
+    printf("frame_check: %d scenarios written to %s\n", ran, o.goldenPath);
+    return 0;
+  }
+  printf("frame_check: %d scenarios, %d frames failed\n", ran, failed);
+  return failed ? 1 : 0;
+}
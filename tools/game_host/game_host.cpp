@@ -0,0 +1,203 @@
+// Pixel Buzz Box - Game Host Runner (Native Build of the Real Sketch)
+//
+// Runs the unmodified game (src/*.cpp) against the stand-ins in host/:
+// setup() once, then loop() until the requested time has passed, with the
+// panel kept as a framebuffer. Frames can be dumped as PPM and the
+// scheduler, latency and panel counters are printed at the end.
+//
+//   pio run -e native
+//   .pio/build/native/program [--ms N] [--ppm DIR] [--every K]
+//                             [--click MS]... [--stick X Y] [--realtime]
+//                             [--record FILE | --replay FILE] [--spi-mhz F]
+//
+// By default time is virtual: tasks take no time and idle waits jump the
+// clock, so runs are exact and repeatable, and the audio core is stepped
+// inline after every loop() instead of on its thread. --realtime follows
+// the host clock with the audio thread running, so scheduler run times,
+// overruns and latencies are real host measurements.
+//
+// --record writes the session's input trace (trace.cpp); --replay plays
+// one back, from a host run or a device capture, in place of the scripted
+// inputs, stops when it runs out and exits 1 if a state hash diverged.
+// --spi-mhz makes panel writes take their bus time at that SPI clock, so
+// frames land (and late-latched frames lead the sim) as they would on the
+// device. A trace recorded without it must replay the same with it: the
+// simulation may not depend on when frames are drawn.
+#include "game.h"
+#include <chrono>
+#include <vector>
+
+void setup();
+void loop();
+
+static const uint32_t CLICK_HOLD_MS = 60;
+
+struct Options {
+  uint32_t runMs = 5000;
+  const char *ppmDir = nullptr;
+  uint32_t every = 1;
+  std::vector<uint32_t> clicksMs;
+  int stickX = 512, stickY = 512;
+  bool realtime = false;
+  bool msGiven = false;
+  const char *recordPath = nullptr;
+  const char *replayPath = nullptr;
+  float spiMhz = 0.0f;
+};
+
+static bool parseArgs(int argc, char **argv, Options &o) {
+  for (int i = 1; i < argc; i++) {
+    const char *a = argv[i];
+    bool more = i + 1 < argc;
+    if (!strcmp(a, "--ms") && more) {
+      o.runMs = (uint32_t)strtoul(argv[++i], nullptr, 10);
+      o.msGiven = true;
+    }
+    else if (!strcmp(a, "--ppm") && more) o.ppmDir = argv[++i];
+    else if (!strcmp(a, "--every") && more) o.every = (uint32_t)strtoul(argv[++i], nullptr, 10);
+    else if (!strcmp(a, "--click") && more) o.clicksMs.push_back((uint32_t)strtoul(argv[++i], nullptr, 10));
+    else if (!strcmp(a, "--stick") && i + 2 < argc) {
+      o.stickX = atoi(argv[++i]);
+      o.stickY = atoi(argv[++i]);
+    } else if (!strcmp(a, "--realtime")) o.realtime = true;
+    else if (!strcmp(a, "--record") && more) o.recordPath = argv[++i];
+    else if (!strcmp(a, "--replay") && more) o.replayPath = argv[++i];
+    else if (!strcmp(a, "--spi-mhz") && more) o.spiMhz = (float)atof(argv[++i]);
+    else return false;
+  }
+  if (o.recordPath && o.replayPath) return false;
+  if (o.replayPath && !o.msGiven) o.runMs = UINT32_MAX;   // Until the trace ends
+  if (o.every == 0) o.every = 1;
+  return true;
+}
+
+// -------------------- INPUT SCRIPT --------------------
+// Button presses at fixed times after boot; the stick is held from boot on
+static void driveInputs(const Options &o, uint32_t elapsedMs) {
+  bool down = false;
+  for (uint32_t at : o.clicksMs) {
+    if (elapsedMs >= at && elapsedMs < at + CLICK_HOLD_MS) down = true;
+  }
+  hostSetPin(PIN_JOY_SW, down ? LOW : HIGH);
+}
+
+// -------------------- TRACE FILES --------------------
+static FILE *recordFile = nullptr;
+static std::vector<uint8_t> replayBytes;
+
+static void fileSink(const uint8_t *data, uint32_t len) {
+  fwrite(data, 1, len, recordFile);
+}
+
+static bool loadReplay(const char *path) {
+  FILE *f = fopen(path, "rb");
+  if (!f) return false;
+  uint8_t chunk[4096];
+  size_t n;
+  while ((n = fread(chunk, 1, sizeof(chunk), f)) > 0) replayBytes.insert(replayBytes.end(), chunk, chunk + n);
+  fclose(f);
+  return traceReplayBegin(replayBytes.data(), (uint32_t)replayBytes.size());
+}
+
+static void printTrace() {
+  const TraceStatus &t = traceStatus();
+  if (recordFile) {
+    printf("trace: recorded %u steps, %u bytes, %u stall flushes\n", t.steps, t.bytes, t.stallFlushes);
+  } else if (!replayBytes.empty()) {
+    printf("trace: replayed %u steps, %u of %zu bytes%s\n", t.steps, t.bytes, replayBytes.size(),
+           t.finished ? "" : " (stopped early)");
+    if (t.diverged) printf("trace: DIVERGED at step %u\n", t.divergedStep);
+    else printf("trace: state hashes match\n");
+  }
+}
+
+// -------------------- REPORT --------------------
+static void printLatency(const char *name, const LatencyStats &s) {
+  uint32_t mean = s.count ? s.totalUs / s.count : 0;
+  printf("  %-18s n=%-7u mean %6u us  worst %6u us\n", name, s.count, mean, s.worstUs);
+}
+
+static void printReport(uint32_t frames, uint32_t dumped, double hostMs) {
+  printf("tasks:\n");
+  for (int i = 0; i < schedulerTaskCount(); i++) {
+    const TaskStats &t = schedulerStats(i);
+    printf("  %-8s runs %-7u overruns %-5u worst latency %6u us  worst run %6u us\n",
+           schedulerTaskName(i), t.runs, t.overruns, t.worstLatencyUs, t.worstRunUs);
+  }
+  printf("latency:\n");
+  printLatency("latch->present", latchToPresent);
+  printLatency("click->response", clickToResponse);
+  printLatency("audio event", audioEventLatency);
+  printf("boot: first frame %u us, first input %u us\n", bootProfile.firstFrameUs,
+         bootProfile.firstInputUs);
+  printf("panel: %u frames, %u tiles, %u pixels pushed, %u dumped\n", frames, tft.tilesPushed(),
+         tft.pixelsPushed(), dumped);
+  printf("host: %.1f ms wall, %.3f ms per frame\n", hostMs, frames ? hostMs / frames : 0.0);
+}
+
+// -------------------- MAIN --------------------
+int main(int argc, char **argv) {
+  Options o;
+  if (!parseArgs(argc, argv, o)) {
+    fprintf(stderr, "usage: %s [--ms N] [--ppm DIR] [--every K] [--click MS]... "
+                    "[--stick X Y] [--realtime] [--record FILE | --replay FILE] [--spi-mhz F]\n", argv[0]);
+    return 2;
+  }
+  if (o.recordPath) {
+    recordFile = fopen(o.recordPath, "wb");
+    if (!recordFile) {
+      fprintf(stderr, "cannot write %s\n", o.recordPath);
+      return 2;
+    }
+    traceRecordBegin(fileSink);
+  }
+  if (o.replayPath && !loadReplay(o.replayPath)) {
+    fprintf(stderr, "cannot replay %s: missing or not a trace\n", o.replayPath);
+    return 2;
+  }
+
+  // Centred at boot so calibration seeds the true center, then held
+  hostSetAnalog(PIN_JOY_VRX, 512);
+  hostSetAnalog(PIN_JOY_VRY, 512);
+  hostSetPin(PIN_JOY_SW, HIGH);
+  hostUseRealClock(o.realtime);
+
+  auto wallStart = std::chrono::steady_clock::now();
+  setup();
+  tft.setBusHz((uint32_t)(o.spiMhz * 1e6f));
+  if (!o.realtime) audioEnd();   // Stepped inline below instead
+  hostSetAnalog(PIN_JOY_VRX, o.stickX);
+  hostSetAnalog(PIN_JOY_VRY, o.stickY);
+
+  uint32_t startMs = millis();
+  uint32_t lastTiles = tft.tilesPushed();
+  uint32_t frames = 0, dumped = 0;
+  for (;;) {
+    uint32_t elapsedMs = millis() - startMs;
+    if (elapsedMs >= o.runMs || traceStatus().finished) break;
+    driveInputs(o, elapsedMs);
+    loop();
+    if (!o.realtime) audioCoreLoop();
+
+    // A frame is complete once the render task has pushed its tiles
+    if (tft.tilesPushed() == lastTiles) continue;
+    lastTiles = tft.tilesPushed();
+    if (o.ppmDir && frames % o.every == 0) {
+      char path[512];
+      snprintf(path, sizeof(path), "%s/frame_%05u_%07ums.ppm", o.ppmDir, frames, elapsedMs);
+      if (tft.savePPM(path)) dumped++;
+      else fprintf(stderr, "cannot write %s\n", path);
+    }
+    frames++;
+  }
+
+  if (o.realtime) audioEnd();
+  if (recordFile) {
+    traceFlush();
+    fclose(recordFile);
+  }
+  double hostMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - wallStart).count();
+  printReport(frames, dumped, hostMs);
+  printTrace();
+  return traceStatus().diverged ? 1 : 0;
+}
@@ -0,0 +1,209 @@
+// Pixel Buzz Box - Grid Bench (Flower Spatial Hash vs Linear Scan)
+//
+// Times the flower index (include/spatial_hash.h, with the game's cell
+// size) against a plain scan over the same points, at 7 (the field's
+// mean), FLOWER_N (the most the game can hold), 100 and 1000 flowers, and
+// checks every query against the scan:
+//
+//   pio run -e grid_bench
+//   .pio/build/grid_bench/program [rounds]
+//
+// Flowers are spread at the game's field density (FLOWER_FIELD_TARGET over
+// the field ring), so more flowers means a bigger world, not a denser one.
+// Queries are the game's: nearest (radar, wasp targets), radius (pollen
+// pickup), view rectangle (renderFrame), anyWithin (spawn spacing), and a
+// remove + insert (collect and regrow). Each count runs on the game's
+// table (FLOWER_GRID_BUCKETS) and, above FLOWER_N, on one scaled to the
+// count. Where the hash itself scans (few points for the cells a query
+// spans), its column should track the scan's. Host numbers are for
+// relative comparison only. Exits 1 if any hash query disagrees with the
+// scan.
+#include "constants.h"
+#include "spatial_hash.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <chrono>
+
+static const int POINT_MAX = 1000;
+static const int QUERY_N = 256;
+static const uint32_t DEFAULT_ROUNDS = 200;
+static const int32_t PICKUP_R = FLOWER_RADIUS_MAX + BEE_HIT_RADIUS;
+static const int32_t VIEW_W = 320, VIEW_H = 240 - HUD_H;   // World units at zoom 1
+
+// -------------------- FIELD --------------------
+struct Field {
+  int n;
+  int32_t x[POINT_MAX], y[POINT_MAX];
+  int32_t qx[QUERY_N], qy[QUERY_N];   // Query points, a quarter of them on flowers
+};
+
+static uint32_t benchSeed = 0xB0A710ADu;
+
+static int32_t benchRand(int32_t lo, int32_t hi) {
+  benchSeed = hash32(benchSeed);
+  return lo + (int32_t)(benchSeed % (uint32_t)(hi - lo + 1));
+}
+
+static void buildField(Field &f, int n) {
+  const float outer = BOUNDARY_COMFORTABLE - FLOWER_FIELD_MARGIN;
+  const float inner = (float)FLOWER_FIELD_INNER;
+  const float areaPerFlower = 3.14159265f * (outer * outer - inner * inner) / FLOWER_FIELD_TARGET;
+  int32_t half = (int32_t)(sqrtf(areaPerFlower * (float)n) * 0.5f);
+  f.n = n;
+  for (int i = 0; i < n; i++) {
+    f.x[i] = benchRand(-half, half);
+    f.y[i] = benchRand(-half, half);
+  }
+  for (int q = 0; q < QUERY_N; q++) {
+    if ((q & 3) == 0) {
+      int i = benchRand(0, n - 1);
+      f.qx[q] = f.x[i] + benchRand(-PICKUP_R, PICKUP_R);
+      f.qy[q] = f.y[i] + benchRand(-PICKUP_R, PICKUP_R);
+    } else {
+      f.qx[q] = benchRand(-half - VIEW_W, half + VIEW_W);
+      f.qy[q] = benchRand(-half - VIEW_H, half + VIEW_H);
+    }
+  }
+}
+
+// -------------------- LINEAR SCAN --------------------
+static int64_t dist2(const Field &f, int i, int32_t x, int32_t y) {
+  int64_t dx = (int64_t)f.x[i] - x, dy = (int64_t)f.y[i] - y;
+  return dx * dx + dy * dy;
+}
+
+static int scanNearest(const Field &f, int32_t x, int32_t y) {
+  int best = -1;
+  int64_t bestD2 = 0;
+  for (int i = 0; i < f.n; i++) {
+    int64_t d2 = dist2(f, i, x, y);
+    if (best < 0 || d2 < bestD2) { best = i; bestD2 = d2; }
+  }
+  return best;
+}
+
+static int scanRadius(const Field &f, int32_t x, int32_t y, int32_t r, int16_t *out) {
+  int n = 0;
+  for (int i = 0; i < f.n; i++) if (dist2(f, i, x, y) <= (int64_t)r * r) out[n++] = (int16_t)i;
+  return n;
+}
+
+static int scanRect(const Field &f, int32_t x0, int32_t y0, int32_t x1, int32_t y1, int16_t *out) {
+  int n = 0;
+  for (int i = 0; i < f.n; i++) {
+    if (f.x[i] >= x0 && f.x[i] <= x1 && f.y[i] >= y0 && f.y[i] <= y1) out[n++] = (int16_t)i;
+  }
+  return n;
+}
+
+static bool scanAnyWithin(const Field &f, int32_t x, int32_t y, int32_t r) {
+  for (int i = 0; i < f.n; i++) if (dist2(f, i, x, y) < (int64_t)r * r) return true;
+  return false;
+}
+
+// -------------------- CROSS-CHECK --------------------
+static bool sameSet(int16_t *a, int na, int16_t *b, int nb) {
+  if (na != nb) return false;
+  std::sort(a, a + na);
+  std::sort(b, b + nb);
+  return std::equal(a, a + na, b);
+}
+
+template <typename Grid>
+static bool crossCheck(const Field &f, const Grid &g) {
+  static int16_t a[POINT_MAX], b[POINT_MAX];
+  for (int q = 0; q < QUERY_N; q++) {
+    int32_t x = f.qx[q], y = f.qy[q];
+    int hn = g.nearest(x, y), sn = scanNearest(f, x, y);
+    if (hn < 0 || dist2(f, hn, x, y) != dist2(f, sn, x, y)) return false;   // Ties may pick either
+    if (!sameSet(a, g.queryRadius(x, y, PICKUP_R, a, POINT_MAX), b, scanRadius(f, x, y, PICKUP_R, b))) return false;
+    int32_t x0 = x - VIEW_W / 2, y0 = y - VIEW_H / 2, x1 = x + VIEW_W / 2, y1 = y + VIEW_H / 2;
+    if (!sameSet(a, g.queryRect(x0, y0, x1, y1, a, POINT_MAX), b, scanRect(f, x0, y0, x1, y1, b))) return false;
+    if (g.anyWithin(x, y, FLOWER_SITE_SPACING) != scanAnyWithin(f, x, y, FLOWER_SITE_SPACING)) return false;
+  }
+  return true;
+}
+
+// -------------------- TIMING --------------------
+// ns per call of fn(q) over every query point, `rounds` times
+template <typename Fn>
+static double timeQueries(uint32_t rounds, Fn fn) {
+  volatile int sink = 0;
+  auto t0 = std::chrono::steady_clock::now();
+  for (uint32_t r = 0; r < rounds; r++) {
+    for (int q = 0; q < QUERY_N; q++) sink = sink + fn(q);
+  }
+  auto t1 = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(t1 - t0).count() / ((double)rounds * QUERY_N);
+}
+
+template <int BUCKETS>
+static bool benchCount(const Field &f, uint32_t rounds, const char *table) {
+  static SpatialHash<POINT_MAX, BUCKETS, FLOWER_GRID_CELL> g;
+  g.clear();
+  for (int i = 0; i < f.n; i++) g.insert(i, f.x[i], f.y[i]);
+  bool ok = crossCheck(f, g);
+
+  // Churn: every flower collected and regrown in place, then check again
+  for (int i = 0; i < f.n; i++) {
+    g.remove(i);
+    g.insert(i, f.x[i], f.y[i]);
+  }
+  ok = ok && g.count() == f.n && crossCheck(f, g);
+
+  static int16_t out[POINT_MAX];
+  double linNear = timeQueries(rounds, [&](int q) { return scanNearest(f, f.qx[q], f.qy[q]); });
+  double hashNear = timeQueries(rounds, [&](int q) { return g.nearest(f.qx[q], f.qy[q]); });
+  double linRad = timeQueries(rounds, [&](int q) { return scanRadius(f, f.qx[q], f.qy[q], PICKUP_R, out); });
+  double hashRad = timeQueries(rounds, [&](int q) {
+    return g.queryRadius(f.qx[q], f.qy[q], PICKUP_R, out, POINT_MAX);
+  });
+  double linRect = timeQueries(rounds, [&](int q) {
+    return scanRect(f, f.qx[q] - VIEW_W / 2, f.qy[q] - VIEW_H / 2, f.qx[q] + VIEW_W / 2, f.qy[q] + VIEW_H / 2, out);
+  });
+  double hashRect = timeQueries(rounds, [&](int q) {
+    return g.queryRect(f.qx[q] - VIEW_W / 2, f.qy[q] - VIEW_H / 2, f.qx[q] + VIEW_W / 2, f.qy[q] + VIEW_H / 2,
+                       out, POINT_MAX);
+  });
+  double linAny = timeQueries(rounds, [&](int q) {
+    return (int)scanAnyWithin(f, f.qx[q], f.qy[q], FLOWER_SITE_SPACING);
+  });
+  double hashAny = timeQueries(rounds, [&](int q) {
+    return (int)g.anyWithin(f.qx[q], f.qy[q], FLOWER_SITE_SPACING);
+  });
+  double churn = timeQueries(rounds, [&](int q) {
+    int i = q % f.n;
+    g.remove(i);
+    g.insert(i, f.x[i], f.y[i]);
+    return g.count();
+  });
+
+  printf("%7d %-6s %7d  %8.0f /%5.0f  %8.0f /%5.0f  %8.0f /%5.0f  %8.0f /%5.0f  %8.0f   %s\n",
+         f.n, table, BUCKETS, linNear, hashNear, linRad, hashRad, linRect, hashRect, linAny, hashAny, churn,
+         ok ? "ok" : "FAIL");
+  return ok;
+}
+
+int main(int argc, char **argv) {
+  uint32_t rounds = argc >= 2 ? (uint32_t)strtoul(argv[1], nullptr, 10) : DEFAULT_ROUNDS;
+  if (rounds == 0) rounds = 1;
+
+  static Field f;
+  bool ok = true;
+  printf("ns per call, linear scan / hash (cell %d world units)\n", (int)FLOWER_GRID_CELL);
+  printf("%7s %-6s %7s  %-17s%-17s%-17s%-17s%s\n", "flowers", "table", "buckets",
+         "nearest", "radius", "view rect", "anyWithin", "remove+insert");
+  buildField(f, 7);
+  ok = benchCount<FLOWER_GRID_BUCKETS>(f, rounds, "game") && ok;
+  buildField(f, FLOWER_N);
+  ok = benchCount<FLOWER_GRID_BUCKETS>(f, rounds, "game") && ok;
+  buildField(f, 100);
+  ok = benchCount<FLOWER_GRID_BUCKETS>(f, rounds, "game") && ok;
+  ok = benchCount<256>(f, rounds, "scaled") && ok;
+  buildField(f, 1000);
+  ok = benchCount<FLOWER_GRID_BUCKETS>(f, rounds, "game") && ok;
+  ok = benchCount<2048>(f, rounds, "scaled") && ok;
+  printf("%s\n", ok ? "PASS" : "FAIL: a hash query disagreed with the linear scan");
+  return ok ? 0 : 1;
+}
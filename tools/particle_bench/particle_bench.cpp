@@ -0,0 +1,80 @@
+// Pixel Buzz Box - Particle Bench (SoA Engine Cost per Population)
+//
+// Boots the game on the host stand-ins and holds the particle engine
+// (src/particles.cpp) at a steady population, topping it up each sim step
+// from all four emitters around the bee, then times the per-step update,
+// the per-frame projection, and drawing into every panel tile:
+//
+//   pio run -e particle_bench
+//   .pio/build/particle_bench/program [steps]
+//
+// Populations run from a busy boost up to PARTICLE_MAX. Host numbers are
+// for relative comparison only.
+#include "game.h"
+#include <chrono>
+
+void setup();
+
+static const uint32_t DEFAULT_STEPS = 20000;
+static const int POPULATIONS[] = {100, 200, PARTICLE_MAX};
+static const int32_t SPREAD = 60;                  // World units around the bee
+static const int FRAME_EVERY = 4;                  // Sim steps per rendered frame (250 Hz / 62.5 fps)
+
+static double nsSince(std::chrono::steady_clock::time_point t0) {
+  return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+}
+
+int main(int argc, char **argv) {
+  uint32_t steps = argc >= 2 ? (uint32_t)strtoul(argv[1], nullptr, 10) : DEFAULT_STEPS;
+  if (steps < (uint32_t)FRAME_EVERY) steps = FRAME_EVERY;
+
+  hostSetAnalog(PIN_JOY_VRX, 512);
+  hostSetAnalog(PIN_JOY_VRY, 512);
+  hostSetPin(PIN_JOY_SW, HIGH);
+  setup();
+  audioEnd();
+
+  printf("%u sim steps per population, a frame every %d steps\n", steps, FRAME_EVERY);
+  printf("  particles   update us/step  ns/particle   project us/frame   draw us/frame\n");
+  for (int population : POPULATIONS) {
+    resetParticles();
+    double updateNs = 0, projectNs = 0, drawNs = 0;
+    uint64_t updated = 0;
+    uint32_t frames = 0;
+
+    for (uint32_t s = 0; s < steps; s++) {
+      // Top up: the kinds in turn, a burst at a time, anywhere near the bee
+      int kind = 0;
+      while (particleCount() < population) {
+        fix16 wx = beeWX + fxFromInt(irand(-SPREAD, SPREAD));
+        fix16 wy = beeWY + fxFromInt(irand(-SPREAD, SPREAD));
+        int burst = population - particleCount();
+        if (burst > 6) burst = 6;
+        emitParticles((EmitterKind)kind, wx, wy, 0, 0, kind == EMIT_BOOST_TRAIL ? (uint8_t)(s & 3) : 0, burst);
+        kind = (kind + 1) % EMITTER_N;
+      }
+
+      updated += (uint64_t)particleCount();
+      auto t0 = std::chrono::steady_clock::now();
+      updateParticles();
+      updateNs += nsSince(t0);
+
+      if (s % FRAME_EVERY != 0) continue;
+      frames++;
+      t0 = std::chrono::steady_clock::now();
+      projectParticles();
+      projectNs += nsSince(t0);
+      for (int tileY = 0; tileY < tft.height(); tileY += CANVAS_H) {
+        for (int tileX = 0; tileX < tft.width(); tileX += CANVAS_W) {
+          canvas.fillScreen(COL_BG0);
+          t0 = std::chrono::steady_clock::now();
+          drawParticles(canvas, -tileX, -tileY);
+          drawNs += nsSince(t0);
+        }
+      }
+    }
+    printf("  %9d   %14.2f  %11.1f   %16.2f   %13.1f\n", population, updateNs / steps / 1000.0,
+           updateNs / (double)updated, projectNs / frames / 1000.0, drawNs / frames / 1000.0);
+  }
+  return 0;
+}
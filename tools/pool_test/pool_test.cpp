@@ -0,0 +1,169 @@
+// Pixel Buzz Box - Pool Test (Host Checks for include/pool.h)
+//
+// Pool<T, N> is header-only with no Arduino dependency, so this builds
+// with any host compiler:
+//
+//   pio run -e pool_test && .pio/build/pool_test/program
+//   g++ -std=gnu++17 -I include tools/pool_test/pool_test.cpp && ./a.out
+//
+// Fixed cases (fill, full, release/reacquire, eviction order, sparse
+// iteration, partial last mask words) plus a randomized run against a
+// plain array model. Exits 1 on the first failed check.
+#include "pool.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+static int checks = 0;
+
+#define CHECK(cond) do { \
+    checks++; \
+    if (!(cond)) { \
+      printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+      exit(1); \
+    } \
+  } while (0)
+
+struct Item {
+  int v;
+};
+
+// -------------------- FIXED CASES --------------------
+// Every capacity around a mask word boundary fills to exactly N, in slot
+// order, and refuses the next acquire
+template <int N>
+static void testFill() {
+  static Pool<Item, N> p;
+  p.clear();
+  CHECK(p.empty() && !p.full() && p.first() == -1);
+  for (int i = 0; i < N; i++) {
+    CHECK(p.acquire() == i);
+    CHECK(p.alive(i) && p.count() == i + 1);
+  }
+  CHECK(p.full() && p.acquire() == -1);
+  int seen = 0;
+  for (int i = p.first(); i >= 0; i = p.next(i)) CHECK(i == seen++);
+  CHECK(seen == N);
+  CHECK(p.next(N - 1) == -1);
+}
+
+static void testReleaseReacquire() {
+  Pool<Item, 40> p;
+  for (int i = 0; i < 40; i++) p.acquire();
+  p.release(17);
+  p.release(5);
+  p.release(33);
+  CHECK(p.count() == 37 && !p.alive(5) && !p.alive(17) && !p.alive(33));
+  p.release(5);                        // Already free: no effect
+  CHECK(p.count() == 37);
+  CHECK(p.acquire() == 5);             // Lowest free first
+  CHECK(p.acquire() == 17);
+  CHECK(p.acquire() == 33);            // In the partial last word
+  CHECK(p.full());
+  p.clear();
+  CHECK(p.empty() && p.first() == -1 && p.acquire() == 0);
+}
+
+static void testEvictionOrder() {
+  Pool<Item, 4> p;
+  for (int i = 0; i < 4; i++) p.acquire();
+  CHECK(p.oldest() == 0);
+  CHECK(p.acquireOrEvict() == 0);      // Full: oldest goes, and is now newest
+  CHECK(p.count() == 4 && p.oldest() == 1);
+  CHECK(p.acquireOrEvict() == 1);
+  p.release(2);
+  CHECK(p.acquireOrEvict() == 2);      // Free slot beats eviction
+  CHECK(p.oldest() == 3);
+  CHECK(p.acquireOrEvict() == 3);
+  CHECK(p.acquireOrEvict() == 0);      // Stamps: 0 < 1 < 2 < 3 again
+  Pool<Item, 4> e;
+  CHECK(e.oldest() == -1);
+}
+
+static void testSparseIteration() {
+  static const int live[] = {0, 31, 32, 63, 64, 95, 99};
+  const int n = (int)(sizeof(live) / sizeof(live[0]));
+  Pool<Item, 100> p;
+  for (int i = 0; i < 100; i++) p.acquire();
+  for (int i = 0; i < 100; i++) {
+    bool keep = false;
+    for (int k = 0; k < n; k++) keep = keep || live[k] == i;
+    if (!keep) p.release(i);
+  }
+  CHECK(p.count() == n);
+  int k = 0;
+  for (int i = p.first(); i >= 0; i = p.next(i)) {
+    CHECK(k < n && i == live[k]);
+    k++;
+  }
+  CHECK(k == n);
+  CHECK(p.next(-1) == 0 && p.next(0) == 31 && p.next(32) == 63 && p.next(99) == -1);
+}
+
+// -------------------- RANDOMIZED --------------------
+// Acquire, evict and release at random against a model with explicit
+// stamps; slot choice, liveness, count, iteration and oldest must agree
+template <int N>
+static void testRandom(uint32_t seed, int ops) {
+  Pool<Item, N> p;
+  bool model[N] = {};
+  uint32_t stamps[N] = {};
+  uint32_t clock = 0;
+  int live = 0;
+
+  for (int op = 0; op < ops; op++) {
+    seed ^= seed << 13; seed ^= seed >> 17; seed ^= seed << 5;
+    int r = (int)(seed % 8u);
+    if (r < 3) {
+      int want = -1;
+      for (int i = 0; i < N && want < 0; i++) if (!model[i]) want = i;
+      CHECK(p.acquire() == want);
+      if (want >= 0) { model[want] = true; stamps[want] = ++clock; live++; }
+    } else if (r < 4) {
+      int want = -1;
+      for (int i = 0; i < N && want < 0; i++) if (!model[i]) want = i;
+      if (want < 0) {
+        for (int i = 0; i < N; i++) if (want < 0 || stamps[i] < stamps[want]) want = i;
+      } else {
+        model[want] = true;
+        live++;
+      }
+      stamps[want] = ++clock;
+      CHECK(p.acquireOrEvict() == want);
+    } else {
+      int i = (int)((seed >> 8) % (uint32_t)N);
+      p.release(i);
+      if (model[i]) { model[i] = false; live--; }
+    }
+
+    CHECK(p.count() == live);
+    int walk = -1;
+    for (int i = 0; i < N; i++) {
+      CHECK(p.alive(i) == model[i]);
+      if (model[i]) {
+        CHECK(p.next(walk) == i);
+        walk = i;
+      }
+    }
+    CHECK(p.next(walk) == -1);
+    int oldest = -1;
+    for (int i = 0; i < N; i++) if (model[i] && (oldest < 0 || stamps[i] < stamps[oldest])) oldest = i;
+    CHECK(p.oldest() == oldest);
+  }
+}
+
+int main() {
+  testFill<1>();
+  testFill<31>();
+  testFill<32>();
+  testFill<33>();
+  testFill<64>();
+  testFill<70>();
+  testReleaseReacquire();
+  testEvictionOrder();
+  testSparseIteration();
+  testRandom<7>(0x1234567u, 20000);
+  testRandom<40>(0x9E3779B9u, 20000);
+  testRandom<96>(0xA5A5F00Du, 20000);
+  printf("PASS: %d checks\n", checks);
+  return 0;
+}
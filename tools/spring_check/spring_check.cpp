@@ -0,0 +1,116 @@
+// Pixel Buzz Box - Spring Check (Bee Integrator vs a Substepped Reference)
+//
+// Flies the bee through updateBeePhysics (src/bee.cpp: the cached
+// closed-form step and its fixed-point per-axis update) on scripted stick
+// moves, and integrates the same spring in double precision with
+// REF_SUBSTEPS RK4 substeps per step alongside it:
+//
+//   pio run -e spring_check
+//   .pio/build/spring_check/program
+//
+// Runs at the simulation step (4 ms) and at 60 ms, cruising and boosted,
+// empty and fully loaded. The reference uses the step the game believes
+// it took (dt as fix16), so the error is the integrator's alone. Exits 1
+// if any position is further than MAX_POS_ERR world units from the
+// reference.
+#include "game.h"
+
+static const int REF_SUBSTEPS = 10000;
+static const double MAX_POS_ERR = 0.13;        // World units
+static const float RUN_SEC = 2.0f;
+
+// Stick moves: held for SEGMENT_SEC each, the last one released so the
+// bee returns to the hive
+struct StickMove {
+  float nx, ny;
+};
+
+static const StickMove moves[] = {
+  {1.0f, 0.0f}, {-0.7f, 0.7f}, {0.3f, -1.0f}, {0.0f, 0.0f},
+};
+static const int MOVE_N = (int)(sizeof(moves) / sizeof(moves[0]));
+static const float SEGMENT_SEC = RUN_SEC / MOVE_N;
+
+// -------------------- REFERENCE --------------------
+// e'' = -k (x - target) - c v, unit mass, as in updateBeePhysics
+struct RefAxis {
+  double x, v;
+};
+
+static void refStep(RefAxis &s, double target, double k, double c, double dt) {
+  double h = dt / REF_SUBSTEPS;
+  for (int i = 0; i < REF_SUBSTEPS; i++) {
+    double x = s.x, v = s.v;
+    double k1x = v,               k1v = -k * (x - target) - c * v;
+    double x2 = x + 0.5 * h * k1x, v2 = v + 0.5 * h * k1v;
+    double k2x = v2,              k2v = -k * (x2 - target) - c * v2;
+    double x3 = x + 0.5 * h * k2x, v3 = v + 0.5 * h * k2v;
+    double k3x = v3,              k3v = -k * (x3 - target) - c * v3;
+    double x4 = x + h * k3x,      v4 = v + h * k3v;
+    double k4x = v4,              k4v = -k * (x4 - target) - c * v4;
+    s.x = x + h / 6.0 * (k1x + 2 * k2x + 2 * k3x + k4x);
+    s.v = v + h / 6.0 * (k1v + 2 * k2v + 2 * k3v + k4v);
+  }
+}
+
+// -------------------- RUN --------------------
+struct RunResult {
+  double maxErr;        // Worst position error over the run
+  float maxErrSec;      // ... and when
+};
+
+static RunResult runCase(fix16 dt, bool boosting, uint8_t load) {
+  resetBee();
+  pollenCount = load;
+
+  // Spring constants as the tuning intends them, in double
+  double loadN = (double)load / MAX_POLLEN_CARRY;
+  double k = fxToFloat(boosting ? SPRING_K_BOOST : SPRING_K_NORMAL)
+           * (1.0 - fxToFloat(CARRY_WEIGHT_SPRING_PENALTY) * loadN);
+  double c = fxToFloat(boosting ? DAMPING_BOOST : DAMPING_NORMAL)
+           * (1.0 + fxToFloat(CARRY_WEIGHT_DAMPING_PENALTY) * loadN);
+  double h = fxToFloat(dt);
+
+  RefAxis rx = {0, 0}, ry = {0, 0};
+  RunResult r = {0, 0};
+  int steps = (int)(RUN_SEC / h + 0.5);
+  for (int i = 0; i < steps; i++) {
+    const StickMove &m = moves[clampi((int)(i * h / SEGMENT_SEC), 0, MOVE_N - 1)];
+    int rawDx = m.nx != 0.0f ? 1 : 0;
+    int rawDy = m.ny != 0.0f ? 1 : 0;
+    updateBeePhysics(m.nx, m.ny, rawDx, rawDy, dt, boosting);
+    refStep(rx, m.nx * BOUNDARY_COMFORTABLE, k, c, h);
+    refStep(ry, m.ny * BOUNDARY_COMFORTABLE, k, c, h);
+
+    double ex = fxToFloat(beeWX) - rx.x;
+    double ey = fxToFloat(beeWY) - ry.x;
+    double err = sqrt(ex * ex + ey * ey);
+    if (err > r.maxErr) {
+      r.maxErr = err;
+      r.maxErrSec = (float)((i + 1) * h);
+    }
+  }
+  return r;
+}
+
+int main() {
+  static const float stepsMs[] = {(float)SIM_STEP_MS, 60.0f};
+  bool ok = true;
+  double worst = 0;
+  for (float ms : stepsMs) {
+    fix16 dt = (ms == (float)SIM_STEP_MS) ? SIM_DT : fxFromFloat(ms / 1000.0f);
+    for (int boost = 0; boost < 2; boost++) {
+      for (int full = 0; full < 2; full++) {
+        RunResult r = runCase(dt, boost != 0, full ? MAX_POLLEN_CARRY : 0);
+        bool pass = r.maxErr < MAX_POS_ERR;
+        printf("dt %4.0f ms %-7s %-6s max error %.4f units at %.2f s  %s\n",
+               ms, boost ? "boost" : "cruise", full ? "loaded" : "empty",
+               r.maxErr, r.maxErrSec, pass ? "ok" : "FAIL");
+        if (r.maxErr > worst) worst = r.maxErr;
+        ok = ok && pass;
+      }
+    }
+  }
+  printf("worst %.4f units (limit %.2f)\n%s\n", worst, MAX_POS_ERR, ok ? "PASS" : "FAIL");
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,56 @@
+// Pixel Buzz Box - Swarm Bench (Wasp Steering Cost per Agent Count)
+//
+// Boots the game on the host stand-ins, then runs updateWasps (src/wasps.cpp:
+// grid neighbour queries, boids steering, goals, move and re-bin) for
+// SIM_SECONDS of simulation steps at several swarm sizes, with the bee
+// circling the hive through the swarm:
+//
+//   pio run -e swarm_bench
+//   .pio/build/swarm_bench/program [seconds]
+//
+// Prints the cost per step and per wasp; a per-wasp figure that stays
+// flat as the swarm grows means neighbour lookup is not quadratic. Host
+// numbers are for relative comparison only.
+#include "game.h"
+#include <chrono>
+
+void setup();
+
+static const uint32_t DEFAULT_SECONDS = 60;
+static const int32_t BEE_ORBIT_R = 120;            // World units around the hive
+static const uint32_t BEE_ORBIT_MS = 4000;         // One lap
+static const int COUNTS[] = {8, 16, 32, WASP_MAX};
+
+int main(int argc, char **argv) {
+  uint32_t seconds = argc >= 2 ? (uint32_t)strtoul(argv[1], nullptr, 10) : DEFAULT_SECONDS;
+  if (seconds == 0) seconds = 1;
+  uint32_t steps = seconds * SIM_HZ;
+
+  hostSetAnalog(PIN_JOY_VRX, 512);
+  hostSetAnalog(PIN_JOY_VRY, 512);
+  hostSetPin(PIN_JOY_SW, HIGH);
+  setup();
+  audioEnd();   // Stings post sounds; nothing plays them here
+
+  printf("%u s of %u ms steps, bee circling at %d units\n", seconds, SIM_STEP_MS, (int)BEE_ORBIT_R);
+  printf("  wasps   us/step   ns/wasp\n");
+  for (int count : COUNTS) {
+    waspsEnabled = true;
+    spawnWasps(count);
+    uint32_t nowMs = millis();
+    double ns = 0;
+    for (uint32_t s = 0; s < steps; s++) {
+      nowMs += SIM_STEP_MS;
+      angle16 a = (angle16)((uint64_t)(nowMs % BEE_ORBIT_MS) * 65536u / BEE_ORBIT_MS);
+      beeWX = fxFromInt(icosScaled(a, BEE_ORBIT_R));
+      beeWY = fxFromInt(isinScaled(a, BEE_ORBIT_R));
+
+      auto t0 = std::chrono::steady_clock::now();
+      updateWasps(SIM_DT, nowMs);
+      auto t1 = std::chrono::steady_clock::now();
+      ns += std::chrono::duration<double, std::nano>(t1 - t0).count();
+    }
+    printf("  %5d  %8.2f  %8.0f\n", waspCount(), ns / steps / 1000.0, ns / steps / waspCount());
+  }
+  return 0;
+}
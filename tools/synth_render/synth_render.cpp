@@ -0,0 +1,412 @@
+// Pixel Buzz Box - Synth Render Tool (Host WAV/CSV Renderer, Benchmark)
+//
+// Replays scripted flight traces through BuzzSynth exactly as the audio
+// task drives it (updateAmbient then updateSound at 1 kHz) and writes the
+// rendered stream as WAV plus a per-millisecond CSV timeline.
+//
+//   pio run -e synth_render
+//   .pio/build/synth_render/program <scenario> [out_prefix]
+//   .pio/build/synth_render/program --bench [calls]
+//   .pio/build/synth_render/program --compare [trace.csv]
+//
+// Scenarios: hover, turns, burst, events. Output is <out_prefix>.wav and
+// <out_prefix>.csv (default prefix: the scenario name). --compare runs the
+// fixed-point ambient model against the float reference below on the
+// scripted traces, or on a recorded CSV (t_ms,vx,vy,speed,wing first, as
+// this tool writes them).
+#include <Arduino.h>
+#include <stdio.h>
+#include <chrono>
+#include <vector>
+#include "BuzzSynth.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HAVE_TSC 1
+#endif
+
+static const int BUZZER_PIN = 15;
+static const float CRUISE_SPEED = 70.0f;      // World units/s
+static const float WING_FULL_SPEED = 120.0f;  // Speed at which wingSpeed reaches 1
+static const uint32_t TICK_US = 1000;         // The audio task's period
+
+// -------------------- SCENARIOS --------------------
+// Bee velocity at time t; posts the scenario's sound events on the way.
+struct Motion {
+  float vx, vy;
+};
+
+enum Scenario { SC_HOVER, SC_TURNS, SC_BURST, SC_EVENTS, SC_COUNT };
+static const char *SCENARIO_NAMES[SC_COUNT] = { "hover", "turns", "burst", "events" };
+static const uint32_t SCENARIO_MS[SC_COUNT] = { 3000, 3000, 2500, 3000 };
+
+// Burst window, also used for the settle report
+static const uint32_t BURST_START_MS = 1000;
+static const uint32_t BURST_END_MS = 1300;
+
+static float rampf(uint32_t t, uint32_t t0, uint32_t t1) {
+  if (t <= t0) return 0.0f;
+  if (t >= t1) return 1.0f;
+  return (float)(t - t0) / (float)(t1 - t0);
+}
+
+static Motion motionAt(Scenario sc, uint32_t t) {
+  Motion m = { 0.0f, 0.0f };
+  switch (sc) {
+    case SC_HOVER: {
+      // Still, ease up to cruise, cruise, stop
+      float s = rampf(t, 500, 900) * (1.0f - rampf(t, 1900, 2100)) * CRUISE_SPEED;
+      m.vx = s;
+      break;
+    }
+    case SC_TURNS: {
+      // Cruise with a hard left/right flip every 400 ms
+      float a = ((t / 400) & 1) ? 2.4f : 0.7f;
+      m.vx = cosf(a) * CRUISE_SPEED;
+      m.vy = sinf(a) * CRUISE_SPEED;
+      break;
+    }
+    case SC_BURST: {
+      float s = 40.0f + 80.0f * rampf(t, BURST_START_MS, BURST_START_MS + 60)
+                              * (1.0f - rampf(t, BURST_END_MS, BURST_END_MS + 60));
+      m.vx = s;
+      break;
+    }
+    default: {
+      // Lazy circle
+      float a = (float)t * 0.0015f;
+      m.vx = cosf(a) * CRUISE_SPEED;
+      m.vy = sinf(a) * CRUISE_SPEED;
+      break;
+    }
+  }
+  return m;
+}
+
+static void postScenarioEvents(BuzzSynth &synth, Scenario sc, uint32_t t) {
+  if (sc != SC_EVENTS) return;
+  switch (t) {
+    case 500:  synth.postSound(SND_CLICK, t); synth.postSound(SND_RADAR, t); break;
+    case 1200: synth.postSound(SND_POLLEN_CHIRP, t); break;
+    case 1250: synth.postSound(SND_POLLEN_CHIRP, t); break;
+    case 1900: synth.postSound(SND_POWERUP, t); break;
+    case 2400: synth.postSound(SND_CLICK, t); break;
+    default: break;
+  }
+}
+
+// -------------------- OUTPUT --------------------
+static std::vector<uint8_t> wavSamples;
+
+static void collectSamples(const uint8_t *samples, uint32_t n) {
+  wavSamples.insert(wavSamples.end(), samples, samples + n);
+}
+
+static void put16(FILE *f, uint16_t v) { fputc(v & 0xFF, f); fputc(v >> 8, f); }
+static void put32(FILE *f, uint32_t v) { put16(f, (uint16_t)v); put16(f, (uint16_t)(v >> 16)); }
+
+// 8-bit unsigned mono PCM, the synth's native format
+static bool writeWav(const char *path, const std::vector<uint8_t> &pcm) {
+  FILE *f = fopen(path, "wb");
+  if (!f) return false;
+  uint32_t n = (uint32_t)pcm.size();
+  fwrite("RIFF", 1, 4, f); put32(f, 36 + n); fwrite("WAVE", 1, 4, f);
+  fwrite("fmt ", 1, 4, f); put32(f, 16); put16(f, 1); put16(f, 1);
+  put32(f, SYNTH_SAMPLE_RATE); put32(f, SYNTH_SAMPLE_RATE); put16(f, 1); put16(f, 8);
+  fwrite("data", 1, 4, f); put32(f, n);
+  fwrite(pcm.data(), 1, n, f);
+  fclose(f);
+  return true;
+}
+
+// -------------------- RENDER --------------------
+static int render(Scenario sc, const char *prefix) {
+  char wavPath[256], csvPath[256];
+  snprintf(wavPath, sizeof(wavPath), "%s.wav", prefix);
+  snprintf(csvPath, sizeof(csvPath), "%s.csv", prefix);
+  FILE *csv = fopen(csvPath, "w");
+  if (!csv) { fprintf(stderr, "cannot write %s\n", csvPath); return 1; }
+  fprintf(csv, "t_ms,vx,vy,speed,wing,mode,ambient_hz,ambient_level,event_hz,event_level,noise_level\n");
+
+  BuzzSynth synth(BUZZER_PIN);
+  synth.begin();
+  synth.setSampleSink(collectSamples);
+  wavSamples.clear();
+
+  // Settle report for the burst: baseline pitch just before it, then the
+  // first time after it that the pitch holds within SETTLE_HZ for 50 ms
+  static const float SETTLE_HZ = 12.0f;
+  float baseSum = 0.0f;
+  int baseN = 0;
+  uint32_t settledAt = 0, inBandSince = 0;
+
+  for (uint32_t t = 0; t <= SCENARIO_MS[sc]; t++) {
+    hostSetMicros(t * 1000u);
+    Motion m = motionAt(sc, t);
+    float speed = sqrtf(m.vx * m.vx + m.vy * m.vy);
+    float wing = speed / WING_FULL_SPEED;
+    if (wing > 1.0f) wing = 1.0f;
+
+    postScenarioEvents(synth, sc, t);
+    synth.updateAmbient(t, TICK_US, fxFromFloat(wing), fxFromFloat(m.vx), fxFromFloat(m.vy), fxFromFloat(speed));
+    synth.updateSound(t);
+
+    float ambientHz = synth.voiceHz(VOICE_AMBIENT);
+    fprintf(csv, "%u,%.2f,%.2f,%.2f,%.3f,%d,%.1f,%u,%.1f,%u,%u\n", t, m.vx, m.vy, speed, wing,
+            (int)synth.getState().mode, ambientHz, synth.voiceLevel(VOICE_AMBIENT),
+            synth.voiceHz(VOICE_EVENT), synth.voiceLevel(VOICE_EVENT), synth.voiceLevel(VOICE_NOISE));
+
+    if (sc == SC_BURST) {
+      if (t >= BURST_START_MS - 200 && t < BURST_START_MS) {
+        baseSum += ambientHz;
+        baseN++;
+      } else if (t > BURST_END_MS + 60 && !settledAt) {
+        if (fabsf(ambientHz - baseSum / baseN) <= SETTLE_HZ) {
+          if (!inBandSince) inBandSince = t;
+          if (t - inBandSince >= 50) settledAt = inBandSince;
+        } else {
+          inBandSince = 0;
+        }
+      }
+    }
+  }
+  fclose(csv);
+
+  if (!writeWav(wavPath, wavSamples)) { fprintf(stderr, "cannot write %s\n", wavPath); return 1; }
+  printf("%s: %u ms, %u samples -> %s, %s\n", SCENARIO_NAMES[sc], SCENARIO_MS[sc],
+         (unsigned)wavSamples.size(), wavPath, csvPath);
+  if (sc == SC_BURST) {
+    if (settledAt) {
+      printf("burst: pitch back within %.0f Hz of %.0f Hz baseline %u ms after the burst ends\n",
+             SETTLE_HZ, baseSum / baseN, settledAt - (BURST_END_MS + 60));
+    } else {
+      printf("burst: pitch did not settle\n");
+    }
+  }
+  const SoundQueueStats &qs = synth.queueStats();
+  if (qs.posted) {
+    printf("events: posted %u started %u merged %u expired %u preempted %u dropped %u\n",
+           qs.posted, qs.started, qs.merged, qs.expired, qs.preempted, qs.dropped);
+  }
+  return 0;
+}
+
+// -------------------- BENCHMARK --------------------
+// Cost of one updateAmbient call on the turns trace (swish, vibrato and
+// smoothing all active). Host numbers are for relative comparison only.
+static int bench(uint32_t calls) {
+  BuzzSynth synth(BUZZER_PIN);
+  synth.begin();
+  struct FxMotion { fix16 vx, vy, speed; };
+  std::vector<FxMotion> trace(SCENARIO_MS[SC_TURNS]);
+  for (uint32_t t = 0; t < trace.size(); t++) {
+    Motion m = motionAt(SC_TURNS, t);
+    trace[t].vx = fxFromFloat(m.vx);
+    trace[t].vy = fxFromFloat(m.vy);
+    trace[t].speed = fxHypot(trace[t].vx, trace[t].vy);
+  }
+
+  volatile fix16 sink = 0;
+  auto t0 = std::chrono::steady_clock::now();
+#ifdef HAVE_TSC
+  uint64_t c0 = __rdtsc();
+#endif
+  for (uint32_t i = 0; i < calls; i++) {
+    const FxMotion &m = trace[i % trace.size()];
+    synth.updateAmbient(i, TICK_US, fxFromFloat(0.6f), m.vx, m.vy, m.speed);
+  }
+#ifdef HAVE_TSC
+  uint64_t c1 = __rdtsc();
+#endif
+  auto t1 = std::chrono::steady_clock::now();
+  sink = synth.getState().ambientFreqSmooth;
+  (void)sink;
+
+  double ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / calls;
+  printf("updateAmbient: %u calls, %.1f ns/call", calls, ns);
+#ifdef HAVE_TSC
+  printf(", %.0f TSC cycles/call", (double)(c1 - c0) / calls);
+#endif
+  printf("\n");
+  return 0;
+}
+
+// -------------------- FLOAT REFERENCE --------------------
+// The ambient pitch model as it was in float, kept to check the Q16.16
+// port against. Pitch and envelope only; no voices, events or tails.
+struct FloatAmbient {
+  float freqSmooth, env, prevVX, prevVY, heading;
+  float turnRateSmooth, accelSmooth, radialAccelSmooth;
+  angle16 vibratoPhase;
+  uint32_t swishUntilMs, swishStartMs;
+  float swishSign;
+  uint32_t accelPulseUntilMs, accelPulseStartMs;
+  float accelPulseStrength;
+};
+
+static float clampRef(float v, float lo, float hi) { return v < lo ? lo : (v > hi ? hi : v); }
+
+static uint32_t hashRef(uint32_t x) {
+  x ^= x >> 16;
+  x *= 0x7feb352du;
+  x ^= x >> 15;
+  x *= 0x846ca68bu;
+  x ^= x >> 16;
+  return x;
+}
+
+static void floatAmbient(FloatAmbient &s, uint32_t nowMs, float dt, float wingSpeed,
+                         float vx, float vy, float speed) {
+  float heading = s.heading;
+  if (speed > 0.02f) heading = atan2f(vy, vx);
+  float dHeading = heading - s.heading;
+  while (dHeading > 3.1415926f) dHeading -= 6.2831853f;
+  while (dHeading < -3.1415926f) dHeading += 6.2831853f;
+  float turnRate = (dt > 0.0001f) ? (dHeading / dt) : 0.0f;
+  s.heading = heading;
+
+  float dvx = vx - s.prevVX;
+  float dvy = vy - s.prevVY;
+  float accelMag = (dt > 0.0001f) ? (sqrtf(dvx * dvx + dvy * dvy) / dt) : 0.0f;
+  float accelAlong = 0.0f;
+  if (speed > 0.02f && dt > 0.0001f) accelAlong = (dvx * vx + dvy * vy) / (speed * dt);
+
+  s.turnRateSmooth += (turnRate - s.turnRateSmooth) * clampRef(6.0f * dt, 0.0f, 1.0f);
+  s.accelSmooth += (accelMag - s.accelSmooth) * clampRef(4.0f * dt, 0.0f, 1.0f);
+  s.radialAccelSmooth += (accelAlong - s.radialAccelSmooth) * clampRef(5.0f * dt, 0.0f, 1.0f);
+
+  if (fabsf(turnRate) > 3.2f && (int32_t)(nowMs - s.swishUntilMs) > 0) {
+    s.swishStartMs = nowMs;
+    s.swishUntilMs = nowMs + 120;
+    s.swishSign = (turnRate >= 0.0f) ? 1.0f : -1.0f;
+  }
+  float accelN = clampRef(accelMag / 420.0f, 0.0f, 1.0f);
+  if (accelN > 0.35f && (int32_t)(nowMs - s.accelPulseUntilMs) > 0) {
+    s.accelPulseStartMs = nowMs;
+    s.accelPulseUntilMs = nowMs + 140;
+    s.accelPulseStrength = accelN;
+  }
+  s.prevVX = vx;
+  s.prevVY = vy;
+
+  float envTarget = (wingSpeed > 0.05f) ? 1.0f : 0.0f;
+  float envRate = (envTarget > s.env) ? 8.0f : 4.0f;
+  s.env += (envTarget - s.env) * clampRef(envRate * dt, 0.0f, 1.0f);
+
+  float base = 220.0f + wingSpeed * 520.0f;
+  uint32_t jitterSeed = hashRef((uint32_t)(nowMs >> 2) + 0x5f3759dfu);
+  float jitter = ((int)(jitterSeed & 0x7u) - 3) * 2.2f;
+  float turnSkew = clampRef(s.turnRateSmooth * 0.75f, -22.0f, 22.0f);
+  float doppler = clampRef(s.radialAccelSmooth * 0.06f, -22.0f, 22.0f);
+  float vibRate = 7.5f + clampRef(fabsf(s.turnRateSmooth) * 0.14f, 0.0f, 6.5f);
+  float vibDepth = 3.5f + wingSpeed * 8.0f + clampRef(s.accelSmooth * 0.045f, 0.0f, 10.0f)
+    + clampRef(fabsf(s.turnRateSmooth) * 0.22f, 0.0f, 7.0f);
+  s.vibratoPhase += (angle16)(vibRate * dt * 65536.0f);
+  float vib = sinf((float)s.vibratoPhase * (6.2831853f / 65536.0f)) * vibDepth;
+
+  float swish = 0.0f;
+  if ((int32_t)(nowMs - s.swishUntilMs) < 0) {
+    float t = clampRef((float)(nowMs - s.swishStartMs) / (float)(s.swishUntilMs - s.swishStartMs), 0.0f, 1.0f);
+    swish = s.swishSign * 18.0f * (1.0f - fabsf(1.0f - 2.0f * t));
+  }
+  float accelPulse = 0.0f;
+  if ((int32_t)(nowMs - s.accelPulseUntilMs) < 0) {
+    float t = clampRef((float)(nowMs - s.accelPulseStartMs) / (float)(s.accelPulseUntilMs - s.accelPulseStartMs), 0.0f, 1.0f);
+    accelPulse = s.accelPulseStrength * 20.0f * (1.0f - t);
+  }
+
+  float target = base + jitter + turnSkew + doppler + vib + swish + accelPulse;
+  s.freqSmooth += (target - s.freqSmooth) * clampRef(10.0f * dt, 0.0f, 1.0f);
+}
+
+// -------------------- COMPARE --------------------
+struct TraceRow {
+  uint32_t t;
+  float vx, vy, wing;
+};
+
+static bool loadTrace(const char *path, std::vector<TraceRow> &rows) {
+  FILE *f = fopen(path, "r");
+  if (!f) return false;
+  char line[512];
+  while (fgets(line, sizeof(line), f)) {
+    TraceRow r;
+    float speed;
+    if (sscanf(line, "%u,%f,%f,%f,%f", &r.t, &r.vx, &r.vy, &speed, &r.wing) == 5) rows.push_back(r);
+  }
+  fclose(f);
+  return !rows.empty();
+}
+
+// Same inputs into both models
+static void compareTrace(const char *name, const std::vector<TraceRow> &rows, float &worstHz) {
+  BuzzSynth synth(BUZZER_PIN);
+  FloatAmbient ref;
+  memset(&ref, 0, sizeof(ref));
+  double sumHz = 0.0;
+  float maxHz = 0.0f, maxEnv = 0.0f;
+  uint32_t prevT = rows[0].t;
+
+  for (const TraceRow &r : rows) {
+    fix16 vx = fxFromFloat(r.vx), vy = fxFromFloat(r.vy);
+    fix16 speed = fxHypot(vx, vy);
+    fix16 wing = fxFromFloat(r.wing);
+    uint32_t dtUs = (r.t - prevT) * 1000u;
+    prevT = r.t;
+
+    synth.updateAmbient(r.t, dtUs, wing, vx, vy, speed);
+    floatAmbient(ref, r.t, (float)dtUs * 1e-6f, fxToFloat(wing), fxToFloat(vx), fxToFloat(vy), fxToFloat(speed));
+
+    const SoundState &s = synth.getState();
+    float dHz = fabsf(fxToFloat(s.ambientFreqSmooth) - ref.freqSmooth);
+    float dEnv = fabsf(fxToFloat(s.ambientEnv) - ref.env);
+    sumHz += dHz;
+    if (dHz > maxHz) maxHz = dHz;
+    if (dEnv > maxEnv) maxEnv = dEnv;
+  }
+  printf("%-8s %6u ticks  pitch |fixed - float| mean %.2f Hz, max %.2f Hz; envelope max %.4f\n",
+         name, (unsigned)rows.size(), sumHz / rows.size(), maxHz, maxEnv);
+  if (maxHz > worstHz) worstHz = maxHz;
+}
+
+static int compare(const char *tracePath) {
+  static const float TOLERANCE_HZ = 4.0f;
+  float worstHz = 0.0f;
+  if (tracePath) {
+    std::vector<TraceRow> rows;
+    if (!loadTrace(tracePath, rows)) { fprintf(stderr, "cannot read %s\n", tracePath); return 1; }
+    compareTrace(tracePath, rows, worstHz);
+  } else {
+    // Scripted flights; events are left out since the reference has no tail
+    for (int sc = 0; sc < SC_EVENTS; sc++) {
+      std::vector<TraceRow> rows;
+      for (uint32_t t = 0; t <= SCENARIO_MS[sc]; t++) {
+        Motion m = motionAt((Scenario)sc, t);
+        float wing = sqrtf(m.vx * m.vx + m.vy * m.vy) / WING_FULL_SPEED;
+        rows.push_back({ t, m.vx, m.vy, wing > 1.0f ? 1.0f : wing });
+      }
+      compareTrace(SCENARIO_NAMES[sc], rows, worstHz);
+    }
+  }
+  bool ok = worstHz <= TOLERANCE_HZ;
+  printf("%s: worst pitch difference %.2f Hz (tolerance %.0f Hz)\n", ok ? "PASS" : "FAIL", worstHz, TOLERANCE_HZ);
+  return ok ? 0 : 1;
+}
+
+int main(int argc, char **argv) {
+  if (argc >= 2 && strcmp(argv[1], "--bench") == 0) {
+    uint32_t calls = (argc >= 3) ? (uint32_t)strtoul(argv[2], nullptr, 10) : 1000000u;
+    return bench(calls ? calls : 1);
+  }
+  if (argc >= 2 && strcmp(argv[1], "--compare") == 0) {
+    return compare(argc >= 3 ? argv[2] : nullptr);
+  }
+  for (int sc = 0; sc < SC_COUNT; sc++) {
+    if (argc >= 2 && strcmp(argv[1], SCENARIO_NAMES[sc]) == 0) {
+      return render((Scenario)sc, argc >= 3 ? argv[2] : SCENARIO_NAMES[sc]);
+    }
+  }
+  fprintf(stderr, "usage: %s hover|turns|burst|events [out_prefix]\n"
+                  "       %s --bench [calls]\n       %s --compare [trace.csv]\n", argv[0], argv[0], argv[0]);
+  return 2;
+}
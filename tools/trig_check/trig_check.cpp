@@ -0,0 +1,231 @@
+// Pixel Buzz Box - Trig Check (FastTrig Error Bounds and Cost vs libm)
+//
+// FastTrig.h is header-only, so this builds with any host compiler, and
+// for the Pico itself:
+//
+//   pio run -e trig_check && .pio/build/trig_check/program [calls]
+//   g++ -O2 -std=gnu++17 -I lib/FixedMath tools/trig_check/trig_check.cpp && ./a.out
+//   pio run -e trig_check_pico -t upload && pio device monitor
+//
+// Checks the bounds the header documents against double-precision libm:
+// isin/icos over every angle16, iatan2 over full circles at many radii
+// plus random vectors out to the int32 extremes, and isqrt32/isqrt64 and
+// fxHypot at every square boundary they can miss. Then times each call
+// against the float libm call it replaced.
+//
+// Only the Pico timings decide anything: it counts clk_sys cycles per
+// call, and its libm is soft-float (the M0+ has no FPU and only a 32-bit
+// multiply). A host's FPU and 64-bit multiply favour libm instead, so host
+// ns per call can rank the two the wrong way round.
+// On the host the program exits 1 if any bound is exceeded; on the Pico
+// it prints PASS or FAIL over USB serial.
+#include "FastTrig.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#if defined(ARDUINO_ARCH_RP2040)
+#include <Arduino.h>
+#define printf Serial.printf
+#else
+#include <chrono>
+#endif
+
+static const double SIN_MAX_ERR = 1.2e-4;      // Absolute, in [-1, 1]
+static const double ATAN2_MAX_ERR = 0.004;     // Radians
+static const double TWO_PI = 6.283185307179586;
+
+#if defined(ARDUINO_ARCH_RP2040)
+static const uint32_t DEFAULT_CALLS = 20000;
+static const char *const TIME_UNIT = "clk_sys cycles per call (RP2040)";
+#else
+static const uint32_t DEFAULT_CALLS = 2000000;
+static const char *const TIME_UNIT = "ns per call (HOST: not the target, relative only)";
+#endif
+
+static uint32_t checkSeed = 0x7A1C0DE5u;
+
+static uint32_t checkRand() {
+  checkSeed ^= checkSeed << 13;
+  checkSeed ^= checkSeed >> 17;
+  checkSeed ^= checkSeed << 5;
+  return checkSeed;
+}
+
+static bool report(const char *what, double worst, double limit, const char *unit) {
+  bool ok = worst < limit;
+  printf("%-28s max error %.3g %s (limit %.3g)  %s\n", what, worst, unit, limit, ok ? "ok" : "FAIL");
+  return ok;
+}
+
+// -------------------- SIN / COS --------------------
+static bool checkSinCos() {
+  double worstSin = 0, worstCos = 0, worstFx = 0;
+  for (uint32_t a = 0; a < 65536; a++) {
+    double rad = (double)a * TWO_PI / 65536.0;
+    double es = fabs(isin((angle16)a) / 32767.0 - sin(rad));
+    double ec = fabs(icos((angle16)a) / 32767.0 - cos(rad));
+    double ef = fabs(fxSin((angle16)a) / 65536.0 - sin(rad));
+    if (es > worstSin) worstSin = es;
+    if (ec > worstCos) worstCos = ec;
+    if (ef > worstFx) worstFx = ef;
+  }
+  bool ok = report("isin, all 65536 angles", worstSin, SIN_MAX_ERR, "");
+  ok = report("icos, all 65536 angles", worstCos, SIN_MAX_ERR, "") && ok;
+  ok = report("fxSin, all 65536 angles", worstFx, SIN_MAX_ERR, "") && ok;
+  bool peaksOk = fxSin(ANGLE_QUARTER) == FX_ONE && fxSin((angle16)(3 * ANGLE_QUARTER)) == -FX_ONE &&
+                 fxCos(0) == FX_ONE && fxCos(ANGLE_HALF) == -FX_ONE && fxSin(0) == 0;
+  printf("%-28s %s\n", "fxSin/fxCos peaks are +/-1", peaksOk ? "ok" : "FAIL");
+  return ok && peaksOk;
+}
+
+// -------------------- ATAN2 --------------------
+static double angleError(angle16 a, double y, double x) {
+  double err = fabs(angleToRadians(a) - atan2(y, x));
+  return err > TWO_PI / 2 ? TWO_PI - err : err;   // -pi and pi are the same angle
+}
+
+static bool checkAtan2() {
+  double worst = 0;
+  static const int32_t radii[] = {1, 2, 3, 5, 10, 100, 1000, 65535, 65536, 1 << 20, 0x7FFFFFFF};
+  for (int32_t r : radii) {
+    for (uint32_t k = 0; k < 4096; k++) {
+      double rad = (double)k * TWO_PI / 4096.0;
+      int32_t x = (int32_t)llround((double)r * cos(rad));
+      int32_t y = (int32_t)llround((double)r * sin(rad));
+      if (x == 0 && y == 0) continue;
+      double e = angleError(iatan2(y, x), (double)y, (double)x);
+      if (e > worst) worst = e;
+    }
+  }
+  for (int k = 0; k < 1000000; k++) {
+    int shift = (int)(checkRand() % 31);
+    int32_t x = (int32_t)checkRand() >> shift;
+    int32_t y = (int32_t)checkRand() >> shift;
+    if (x == 0 && y == 0) continue;
+    double e = angleError(iatan2(y, x), (double)y, (double)x);
+    if (e > worst) worst = e;
+  }
+  bool axesOk = iatan2(0, 0) == 0 && iatan2(0, 5) == 0 && iatan2(5, 0) == ANGLE_QUARTER &&
+                iatan2(0, -5) == ANGLE_HALF && iatan2(-5, 0) == (angle16)-ANGLE_QUARTER;
+  printf("%-28s %s\n", "iatan2 axes and (0, 0)", axesOk ? "ok" : "FAIL");
+  return report("iatan2, circles + random", worst, ATAN2_MAX_ERR, "rad") && axesOk;
+}
+
+// -------------------- SQUARE ROOT --------------------
+// floor(sqrt) is exact: every r*r - 1, r*r and r*r + 1 lands on r - 1 or r
+static bool checkSqrt() {
+  bool ok = true;
+  for (uint32_t v = 0; v < (1u << 22) && ok; v++) {
+    uint32_t r = isqrt32(v);
+    ok = (uint64_t)r * r <= v && (uint64_t)(r + 1) * (r + 1) > v;
+  }
+  for (uint32_t r = 1; r <= 0xFFFFu && ok; r++) {
+    uint32_t sq = r * r;
+    ok = isqrt32(sq) == r && isqrt32(sq - 1) == r - 1 && (r == 0xFFFFu || isqrt32(sq + 1) == r);
+  }
+  ok = ok && isqrt32(0xFFFFFFFFu) == 0xFFFFu;
+  printf("%-28s %s\n", "isqrt32 exact", ok ? "ok" : "FAIL");
+
+  bool ok64 = true;
+  for (int k = 0; k < 1000000 && ok64; k++) {
+    uint32_t r = checkRand() | 1u;
+    uint64_t sq = (uint64_t)r * r;
+    ok64 = isqrt64(sq) == r && isqrt64(sq - 1) == r - 1 && (r == 0xFFFFFFFFu || isqrt64(sq + 1) == r);
+  }
+  ok64 = ok64 && isqrt64(0xFFFFFFFFFFFFFFFFull) == 0xFFFFFFFFu && isqrt64(1ull << 32) == 65536u;
+  printf("%-28s %s\n", "isqrt64 exact", ok64 ? "ok" : "FAIL");
+
+  double worst = 0;
+  for (int k = 0; k < 1000000; k++) {
+    fix16 x = (fix16)((int32_t)checkRand() >> (checkRand() % 8 + 1));
+    fix16 y = (fix16)((int32_t)checkRand() >> (checkRand() % 8 + 1));
+    double e = fabs((double)fxHypot(x, y) - hypot((double)x, (double)y));
+    if (e > worst) worst = e;
+  }
+  bool hypotOk = report("fxHypot (Q16.16 LSB)", worst, 1.0, "LSB");
+  return ok && ok64 && hypotOk;
+}
+
+// -------------------- TIMING --------------------
+// TIME_UNIT per call over a precomputed input table, loop overhead
+// included on both sides
+template <typename Fn>
+static double timeCalls(uint32_t calls, Fn fn) {
+  volatile int32_t sink = 0;
+#if defined(ARDUINO_ARCH_RP2040)
+  uint64_t c0 = rp2040.getCycleCount64();
+  for (uint32_t i = 0; i < calls; i++) sink = sink + fn(i & 4095u);
+  return (double)(rp2040.getCycleCount64() - c0) / calls;
+#else
+  auto t0 = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < calls; i++) sink = sink + fn(i & 4095u);
+  auto t1 = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(t1 - t0).count() / calls;
+#endif
+}
+
+static void benchmark(uint32_t calls) {
+  static angle16 ang[4096];
+  static float rad[4096], fx[4096], fy[4096], fv[4096];
+  static int32_t ix[4096], iy[4096];
+  static uint32_t iv[4096];
+  static fix16 hx[4096], hy[4096];
+  for (int i = 0; i < 4096; i++) {
+    ang[i] = (angle16)checkRand();
+    rad[i] = angleToRadians(ang[i]);
+    ix[i] = (int32_t)(checkRand() % 2001) - 1000;
+    iy[i] = (int32_t)(checkRand() % 2001) - 1000;
+    fx[i] = (float)ix[i];
+    fy[i] = (float)iy[i];
+    iv[i] = checkRand() >> 8;
+    fv[i] = (float)iv[i];
+    hx[i] = (fix16)((int32_t)checkRand() >> 9);
+    hy[i] = (fix16)((int32_t)checkRand() >> 9);
+  }
+
+  printf("\n%s, %u calls\n", TIME_UNIT, (unsigned)calls);
+  printf("  %-36s %10s  %10s\n", "", "libm float", "FastTrig");
+  double o, n;
+  o = timeCalls(calls, [&](uint32_t i) { return (int32_t)(sinf(rad[i]) * 32767.0f); });
+  n = timeCalls(calls, [&](uint32_t i) { return (int32_t)isin(ang[i]); });
+  printf("  %-36s %10.2f  %10.2f\n", "sinf(rad) / isin(angle16)", o, n);
+  o = timeCalls(calls, [&](uint32_t i) { return (int32_t)(cosf(rad[i]) * 32767.0f); });
+  n = timeCalls(calls, [&](uint32_t i) { return (int32_t)icos(ang[i]); });
+  printf("  %-36s %10.2f  %10.2f\n", "cosf(rad) / icos(angle16)", o, n);
+  o = timeCalls(calls, [&](uint32_t i) { return (int32_t)(atan2f(fy[i], fx[i]) * ANGLE_PER_RADIAN); });
+  n = timeCalls(calls, [&](uint32_t i) { return (int32_t)iatan2(iy[i], ix[i]); });
+  printf("  %-36s %10.2f  %10.2f\n", "atan2f / iatan2", o, n);
+  o = timeCalls(calls, [&](uint32_t i) { return (int32_t)sqrtf(fv[i]); });
+  n = timeCalls(calls, [&](uint32_t i) { return (int32_t)isqrt32(iv[i]); });
+  printf("  %-36s %10.2f  %10.2f\n", "sqrtf / isqrt32", o, n);
+  o = timeCalls(calls, [&](uint32_t i) { return fxFromFloat(hypotf(fxToFloat(hx[i]), fxToFloat(hy[i]))); });
+  n = timeCalls(calls, [&](uint32_t i) { return fxHypot(hx[i], hy[i]); });
+  printf("  %-36s %10.2f  %10.2f\n", "hypotf / fxHypot", o, n);
+}
+
+static bool runAll(uint32_t calls) {
+  bool ok = checkSinCos();
+  ok = checkAtan2() && ok;
+  ok = checkSqrt() && ok;
+  benchmark(calls);
+  printf("%s\n", ok ? "PASS" : "FAIL");
+  return ok;
+}
+
+#if defined(ARDUINO_ARCH_RP2040)
+// Soft-float double libm makes the checks take a few minutes here
+void setup() {
+  Serial.begin(115200);
+  while (!Serial) delay(10);
+  runAll(DEFAULT_CALLS);
+}
+
+void loop() {}
+#else
+int main(int argc, char **argv) {
+  uint32_t calls = argc >= 2 ? (uint32_t)strtoul(argv[1], nullptr, 10) : DEFAULT_CALLS;
+  if (calls == 0) calls = 1;
+  return runAll(calls) ? 0 : 1;
+}
+#endif